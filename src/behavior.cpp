@@ -14,6 +14,7 @@
 
 // Engine includes //
 #include "behavior.hpp"
+#include "command_buffer.hpp"
 #include "engine.hpp"
 #include "object.hpp"
 #include "object_manager.hpp"
@@ -26,26 +27,36 @@
  * @brief Creates an empty Behavior object
  * 
  */
-Behavior::Behavior() : Component(CType::CBehavior) {}
+Behavior::Behavior() : Component(GetCType()), isStarted(false) {}
 
 /**
- * @brief Copy constructor
+ * @brief Copy constructor. The copy makes its own lua states when it is first
+ *        updated, so copies that never run (spawn templates, objects removed
+ *        before they are added) don't make any
  * 
  * @param other Behavior object to copy
  */
-Behavior::Behavior(const Behavior& other) : Component(CType::CBehavior) {
-    *this = other;
-}
+Behavior::Behavior(const Behavior& other) : Component(GetCType()), scripts(other.scripts), isStarted(false) {}
 
 /**
  * @brief Creates Behavior object using file
  * 
  * @param reader Data from file
  */
-Behavior::Behavior(File_Reader& reader) : Component(CType::CBehavior) {
+Behavior::Behavior(File_Reader& reader) : Component(GetCType()), isStarted(false) {
     Read(reader);
 }
 
+/**
+ * @brief Creates Behavior object using a list of scripts that was already read
+ *        (shared until this Behavior changes it). The lua states are made when
+ *        the scripts are started
+ * 
+ * @param scripts_ Names of the lua scripts
+ */
+Behavior::Behavior(std::shared_ptr<std::vector<std::string>> scripts_) : Component(GetCType()), scripts(scripts_),
+    isStarted(false) {}
+
 /**
  * @brief Clones current Behavior object
  * 
@@ -65,10 +76,12 @@ Behavior::~Behavior() {
 
 /**
  * @brief Update for Behavior object. Calls Behavior manager giving list of its
- *        behaviors
+ *        behaviors (scripts that weren't started yet are started first)
  * 
  */
 void Behavior::Update() {
+    if (!isStarted) SetupClassesForLua();
+
     for (sol::state* state : states) {
         if (!state) continue;
         (*state)["FixedUpdate"](Engine::GetDt());
@@ -81,6 +94,20 @@ void Behavior::Update() {
  * @param reader Data from file
  */
 void Behavior::Read(File_Reader& reader) {
+    scripts = ReadScripts(reader);
+
+      // Creating lua state for each of the scripts that were read in
+    CreateStates();
+}
+
+/**
+ * @brief Reads the names of the lua files from the file
+ * 
+ * @param reader Data from file
+ * @return std::shared_ptr<std::vector<std::string>> 
+ */
+std::shared_ptr<std::vector<std::string>> Behavior::ReadScripts(File_Reader& reader) {
+    std::shared_ptr<std::vector<std::string>> scriptList = std::make_shared<std::vector<std::string>>();
     unsigned behavior_num = 0;
 
       // Reads the name of the lua files
@@ -90,15 +117,11 @@ void Behavior::Read(File_Reader& reader) {
         if (behavior_name.compare("") == 0) break;
         if (behavior_name.find(".lua") == std::string::npos) continue;
           // Adding lua filename to list
-        scripts.emplace_back(std::string(getenv("USERPROFILE")) + "/Documents/pEngine/scripts/" + behavior_name);
+        scriptList->emplace_back(Engine::GetDataPath() + "scripts/" + behavior_name);
         ++behavior_num;
     }
-      // Creating lua state for each of the scripts that were read in
-    for (unsigned i = 0; i < scripts.size(); ++i) {
-        sol::state* state = new sol::state;
-        state->open_libraries(sol::lib::base, sol::lib::math, sol::lib::io, sol::lib::string);
-        states.emplace_back(state);
-    }
+
+    return scriptList;
 }
 
 /**
@@ -107,29 +130,24 @@ void Behavior::Read(File_Reader& reader) {
  * @param writer 
  */
 void Behavior::Write(File_Writer& writer) {
-    writer.Write_Behavior_Name(scripts);
+    writer.Write_Behavior_Name(GetScripts());
 }
 
 /**
- * @brief Gets the CType of Behavior (used in Object::GetComponent<>())
- * 
- * @return CType 
- */
-CType Behavior::GetCType() {
-    return CType::CBehavior;
-}
-
-/**
- * @brief Setups up the interface between the engine and the lua files
+ * @brief Setups up the interface between the engine and the lua files, making
+ *        any lua states that are missing, and runs Start() of each script
  * 
  */
 void Behavior::SetupClassesForLua() {
+    CreateStates();
+    isStarted = true;
+
     for (sol::state* state : states) {
         ClassSetup(state);
     }
 
     for (unsigned i = 0; i < states.size(); ++i) {
-        states[i]->script_file(scripts[i]);
+        states[i]->script_file((*scripts)[i]);
         (*states[i])["Start"]();
     }
 }
@@ -137,9 +155,13 @@ void Behavior::SetupClassesForLua() {
 /**
  * @brief Returns list of lua filenames
  * 
- * @return std::vector<std::string>& 
+ * @return const std::vector<std::string>& 
  */
-std::vector<std::string>& Behavior::GetScripts() { return scripts; }
+const std::vector<std::string>& Behavior::GetScripts() const {
+    static const std::vector<std::string> noScripts;
+    if (!scripts) return noScripts;
+    return *scripts;
+}
 
 /**
  * @brief Sends engine variables and functions to lua
@@ -151,6 +173,11 @@ void Behavior::ClassSetup(sol::state* state) {
     state->set_function("random_vec3", Random::random_vec3);
     state->set_function("random_float", Random::random_float);
 
+      // Giving lua the speed of simulated time (scripts can skip work that
+      // is only seen when time runs at normal speed)
+    state->set_function("GetTimeScale", []() { return Engine::GetTimeScale(); });
+    state->set_function("IsFastForward", []() { return Engine::GetFastForward(); });
+
       // Giving lua glm::vec3 wrapper class
     sol::usertype<glm::vec3> vec3_type = state->new_usertype<glm::vec3>("vec3",
         sol::constructors<glm::vec3(float, float, float), glm::vec3(float)>());
@@ -169,34 +196,67 @@ void Behavior::ClassSetup(sol::state* state) {
 
     state->set_function("FindObject", sol::overload(sol::resolve<Object*(int)>(&Object_Manager::FindObject), 
         sol::resolve<Object*(std::string)>(&Object_Manager::FindObject)));
+    state->set_function("SpawnObjects", [](std::string templateName, std::string objectName, unsigned count,
+        std::string distribution, glm::vec3 center, glm::vec3 size, glm::vec3 scale) {
+        return Object_Manager::SpawnObjects(templateName, objectName, count, distribution, center, size, scale);
+    });
+    state->set_function("DestroyObject", Command_Buffer::DestroyObject);
 
       // Giving lua physics class
     sol::usertype<Physics> physics_type = state->new_usertype<Physics>("Physics",
         sol::constructors<Physics(), Physics(const Physics)>());
       // Giving lua physics class variables
-    physics_type.set("acceleration", sol::property(Physics::GetAccelerationRef, &Physics::SetAcceleration));
-    physics_type.set("forces",       sol::property(Physics::GetForcesRef,       &Physics::SetForces));
-    physics_type.set("velocity",     sol::property(Physics::GetVelocityRef,     &Physics::SetVelocity));
+#ifdef PENGINE_DOUBLE_PRECISION
+      // Scripts work in float, the double precision state is copied in and out
+    physics_type.set("acceleration", sol::property(
+        [](Physics& physics) { return glm::vec3(physics.GetAcceleration()); },
+        [](Physics& physics, glm::vec3 value) { physics.SetAcceleration(value); }));
+    physics_type.set("forces", sol::property(
+        [](Physics& physics) { return glm::vec3(physics.GetForces()); },
+        [](Physics& physics, glm::vec3 value) { physics.SetForces(value); }));
+    physics_type.set("velocity", sol::property(
+        [](Physics& physics) { return glm::vec3(physics.GetVelocity()); },
+        [](Physics& physics, glm::vec3 value) { physics.SetVelocity(value); }));
+#else
+      // Reading gives a copy, so only assigning the whole vector changes the body
+    physics_type.set("acceleration", sol::property(&Physics::GetAcceleration, &Physics::SetAcceleration));
+    physics_type.set("forces",       sol::property(&Physics::GetForces,       &Physics::SetForces));
+    physics_type.set("velocity",     sol::property(&Physics::GetVelocity,     &Physics::SetVelocity));
+#endif
       // Giving lua physics class functions
     physics_type.set_function("ApplyForce",    &Physics::ApplyForce);
     physics_type.set_function("UpdateGravity", &Physics::UpdateGravity);
+    physics_type.set_function("GetNearbyObjects", [](const Physics& physics) {
+        return sol::as_table(physics.GetNearbyObjects());
+    });
 
       // Giving lua transform class
     sol::usertype<Transform> transform_type = state->new_usertype<Transform>("Transform",
         sol::constructors<Transform(), Transform(const Transform)>());
-      // Giving lua transform class variables
-    transform_type.set("position",      sol::property(Transform::GetPositionRef,      &Transform::SetPosition));
-    transform_type.set("rotation",      sol::property(Transform::GetRotationRef,      &Transform::SetRotation));
-    transform_type.set("scale",         sol::property(Transform::GetScaleRef,         &Transform::SetScale));
-    transform_type.set("startPosition", sol::property(Transform::GetStartPositionRef, &Transform::SetStartPosition));
+      // Giving lua transform class variables (read through the const getters so
+      // looking at a transform doesn't mark it as moved, assigning the whole
+      // vector changes it)
+    transform_type.set("rotation",      sol::property(&Transform::GetRotation,      &Transform::SetRotation));
+    transform_type.set("scale",         sol::property(&Transform::GetScale,         &Transform::SetScale));
+#ifdef PENGINE_DOUBLE_PRECISION
+    transform_type.set("position", sol::property(
+        [](Transform& transform) { return glm::vec3(transform.GetPosition()); },
+        [](Transform& transform, glm::vec3 value) { transform.SetPosition(value); }));
+    transform_type.set("startPosition", sol::property(
+        [](Transform& transform) { return glm::vec3(transform.GetStartPosition()); },
+        [](Transform& transform, glm::vec3 value) { transform.SetStartPosition(value); }));
+#else
+    transform_type.set("position",      sol::property(&Transform::GetPosition,      &Transform::SetPosition));
+    transform_type.set("startPosition", sol::property(&Transform::GetStartPosition, &Transform::SetStartPosition));
+#endif
 
       // Giving lua object class
     state->set("object", GetParent());
     sol::usertype<Object> object_type = state->new_usertype<Object>("Object",
         sol::constructors<Object(), Object(const Object)>());
       // Giving lua object class variables
-    object_type.set("name", sol::property(Object::GetNameRef, &Object::SetName));
-    object_type.set("id",   sol::readonly_property(Object::GetId));
+    object_type.set("name", sol::property(&Object::GetNameRef, &Object::SetName));
+    object_type.set("id",   sol::readonly_property(&Object::GetId));
     object_type.set_function("GetPhysics", &Object::GetComponent<Physics>);
     object_type.set_function("GetTransform", &Object::GetComponent<Transform>);
 }
@@ -214,10 +274,11 @@ bool Behavior::SwitchScript(unsigned scriptNum, std::string newScriptName) {
     if (CheckIfCopy(newScriptName)) return false;
     if (newScriptName.compare(".lua") == 0) return false;
     if (newScriptName.find(".lua") == std::string::npos) return false;
+    if (!isStarted) SetupClassesForLua();
     sol::state* state = states[scriptNum];
-    scripts[scriptNum] = newScriptName;
+    EditScripts()[scriptNum] = newScriptName;
       // Setting up new lua script
-    state->script_file(scripts[scriptNum]);
+    state->script_file(newScriptName);
     (*state)["Start"]();
 
     return true;
@@ -234,15 +295,16 @@ bool Behavior::AddScript(std::string newScriptName) {
       // Checking if this script is already attached
     if (newScriptName.find(".lua") == std::string::npos) return false;
     if (CheckIfCopy(newScriptName)) return false;
+    if (!isStarted) SetupClassesForLua();
       // Setting up new lua state
     sol::state* state = new sol::state;
     state->open_libraries(sol::lib::base, sol::lib::math, sol::lib::io, sol::lib::string);
     states.emplace_back(state);
       // Adding new script filename to list
-    scripts.emplace_back(newScriptName);
+    EditScripts().emplace_back(newScriptName);
     ClassSetup(state);
       // Setting up lua script to run
-    states.back()->script_file(scripts.back());
+    states.back()->script_file(newScriptName);
     (*states.back())["Start"]();
 
     return true;
@@ -257,7 +319,7 @@ bool Behavior::AddScript(std::string newScriptName) {
  */
 bool Behavior::CheckIfCopy(std::string newScriptName) {
       // Checking if script is the same as an existing one
-    for (std::string scriptName : scripts) {
+    for (const std::string& scriptName : GetScripts()) {
         if (scriptName.compare(newScriptName) == 0) return true;
     }
 
@@ -277,5 +339,33 @@ void Behavior::Clear() {
     }
 
     states.clear();
-    scripts.clear();
+    scripts.reset();
+    isStarted = false;
+}
+
+/**
+ * @brief Creates a lua state for each script that doesn't have one yet
+ * 
+ */
+void Behavior::CreateStates() {
+    for (unsigned i = states.size(); i < GetScripts().size(); ++i) {
+        sol::state* state = new sol::state;
+        state->open_libraries(sol::lib::base, sol::lib::math, sol::lib::io, sol::lib::string);
+        states.emplace_back(state);
+    }
+}
+
+/**
+ * @brief Returns the list of scripts so it can be changed. The list is copied
+ *        first if other Behaviors (or a prototype) are using it
+ * 
+ * @return std::vector<std::string>& 
+ */
+std::vector<std::string>& Behavior::EditScripts() {
+    if (!scripts)
+        scripts = std::make_shared<std::vector<std::string>>();
+    else if (scripts.use_count() > 1)
+        scripts = std::make_shared<std::vector<std::string>>(*scripts);
+
+    return *scripts;
 }
@@ -14,6 +14,8 @@
 #define BEHAVIOR_HPP
 
 // std includes //
+#include <memory>
+#include <string>
 #include <vector>
 
 // Library includes //
@@ -25,14 +27,16 @@
 #include "component.hpp"
 #include "file_reader.hpp"
 #include "file_writer.hpp"
+#include "pool.hpp"
 
 /*! Behavior class */
-class Behavior : public Component {
+class Behavior : public Component, public Pooled<Behavior> {
     public:
         Behavior();
         Behavior(const Behavior& other);
         Behavior(File_Reader& reader);
-        Behavior* Clone() const;
+        Behavior(std::shared_ptr<std::vector<std::string>> scripts_);
+        Behavior* Clone() const override;
         ~Behavior();
 
         void Update();
@@ -40,11 +44,17 @@ class Behavior : public Component {
         void Read(File_Reader& reader);
         void Write(File_Writer& writer);
 
-        static CType GetCType();
+        /**
+         * @brief Gets the CType of Behavior (used in Object::GetComponent<>())
+         * 
+         * @return CType 
+         */
+        static constexpr CType GetCType() { return TypeOf<Behavior>(); }
 
         void SetupClassesForLua();
 
-        std::vector<std::string>& GetScripts();
+        static std::shared_ptr<std::vector<std::string>> ReadScripts(File_Reader& reader);
+        const std::vector<std::string>& GetScripts() const;
         
         void ClassSetup(sol::state* state);
         bool SwitchScript(unsigned scriptNum, std::string newScriptName);
@@ -52,8 +62,14 @@ class Behavior : public Component {
         bool CheckIfCopy(std::string newScriptName);
         void Clear();
     private:
-        std::vector<std::string> scripts; //!< Names of the lua scripts being used
-        std::vector<sol::state*> states;  //!< States of each lua script
+        void CreateStates();
+        std::vector<std::string>& EditScripts();
+    private:
+        std::shared_ptr<std::vector<std::string>> scripts; //!< Names of the lua scripts being used (shared
+                                                           //!< with copies until one of them changes it)
+        std::vector<sol::state*> states;                   //!< States of each lua script
+        bool isStarted;                                    //!< Whether Start() was run (copies wait for
+                                                           //!< their first update)
 };
 
 #endif
\ No newline at end of file
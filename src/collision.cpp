@@ -0,0 +1,423 @@
+/**
+ * @file collision.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-14
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// std includes //
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+
+// Library includes //
+#include <glm.hpp>
+
+// Engine includes //
+  // System //
+#include "collision.hpp"
+#include "command_buffer.hpp"
+#include "gravity.hpp"
+#include "job_system.hpp"
+#include "neighbor_list.hpp"
+  // Component //
+#include "component_storage.hpp"
+#include "physics.hpp"
+#include "transform.hpp"
+  // Misc //
+#include "trace.hpp"
+
+static Collision* collision = nullptr; //!< Collision object
+
+const char* Collision::broadphaseNames[BroadphaseCount] = { "none", "grid", "sweep", "neighbors" };
+
+/**
+ * @brief Wakes the body so the Integrator steps it again (it was pushed)
+ *
+ */
+static inline void Wake(Physics_Data& physics, unsigned entity) {
+    physics.isSleeping[entity] = 0;
+    physics.restTime[entity] = 0.f;
+}
+
+/**
+ * @brief Initializes the collision system using the settings of the preset
+ *
+ * @param preset Preset being loaded
+ * @return true
+ * @return false
+ */
+bool Collision::Initialize(File_Reader& preset) {
+    if (!Initialize()) return false;
+
+    collision->restitution = glm::clamp(preset.Read_Float("restitution"), 0.f, 1.f);
+    collision->merge = preset.Read_Bool("mergeOnCollision");
+
+    std::string broadphaseName = preset.Read_String("collisions");
+    if (broadphaseName.empty()) return true;
+
+    for (unsigned i = 0; i < BroadphaseCount; ++i) {
+        if (broadphaseName == broadphaseNames[i]) {
+            collision->broadphase = Broadphase(i);
+            return true;
+        }
+    }
+
+    Trace::Message("Unknown collisions '" + broadphaseName + "', using none.\n");
+    return true;
+}
+
+/**
+ * @brief Initializes the collision system with collisions turned off
+ *
+ * @return true
+ * @return false
+ */
+bool Collision::Initialize() {
+      // Initializing collision
+    collision = new Collision;
+    if (!collision) {
+        Trace::Message("Collision was not initialized.\n");
+        return false;
+    }
+
+    collision->broadphase = None;
+    collision->restitution = 0.f;
+    collision->merge = false;
+    collision->hasShortLists = false;
+
+    return true;
+}
+
+/**
+ * @brief Finds every pair of touching spheres and either bounces them apart or
+ *        merges them. Called after the bodies are moved each step
+ *
+ * @return void
+ */
+void Collision::Update() {
+    collision->contacts.clear();
+    if (collision->broadphase == None) return;
+
+    collision->Pack();
+    if (collision->positions.size() < 2) return;
+
+      // Each thread keeps the contacts it finds in its own list
+    collision->threadContacts.resize(Job_System::GetThreadCount());
+    for (std::vector<Contact>& found : collision->threadContacts) found.clear();
+
+    if (collision->broadphase == Grid) collision->FindGridPairs();
+    else if (collision->broadphase == Neighbors) collision->FindNeighborPairs();
+    else collision->FindSweepPairs();
+
+      // Contacts are handled in the same order every run, however the threads
+      // split the work
+    std::vector<Contact>& contacts = collision->contacts;
+    for (const std::vector<Contact>& found : collision->threadContacts) {
+        contacts.insert(contacts.end(), found.begin(), found.end());
+    }
+    std::sort(contacts.begin(), contacts.end(), [](const Contact& left, const Contact& right) {
+        return left.a != right.a ? left.a < right.a : left.b < right.b;
+    });
+
+    for (const Contact& contact : contacts) {
+        if (collision->isRemoved[contact.a] || collision->isRemoved[contact.b]) continue;
+
+        if (collision->merge) collision->Merge(contact);
+        else collision->Resolve(contact);
+    }
+}
+
+/**
+ * @brief Deletes the collision object
+ *
+ * @return void
+ */
+void Collision::Shutdown() {
+    if (!collision) return;
+
+    delete collision;
+    collision = nullptr;
+}
+
+/**
+ * @brief Gives the collision settings to the writer
+ *
+ * @param writer
+ * @return void
+ */
+void Collision::Write(File_Writer& writer) {
+    writer.Write_String("collisions", broadphaseNames[collision->broadphase]);
+    writer.Write_Value("restitution", collision->restitution);
+    writer.Write_Value("mergeOnCollision", collision->merge);
+}
+
+/**
+ * @brief Returns the broadphase being used
+ *
+ * @return Collision::Broadphase
+ */
+Collision::Broadphase Collision::GetBroadphase() { return collision->broadphase; }
+
+/**
+ * @brief Sets the broadphase used from the next step on
+ *
+ * @param broadphase_
+ * @return void
+ */
+void Collision::SetBroadphase(Broadphase broadphase_) {
+    if (broadphase_ < 0 || broadphase_ >= BroadphaseCount) return;
+    collision->broadphase = broadphase_;
+}
+
+/**
+ * @brief Returns reference to the bounciness of collisions
+ *
+ * @return float&
+ */
+float& Collision::GetRestitution() { return collision->restitution; }
+
+/**
+ * @brief Returns reference to whether touching bodies merge
+ *
+ * @return bool&
+ */
+bool& Collision::GetMerge() { return collision->merge; }
+
+/**
+ * @brief Returns the number of touching pairs found last step
+ *
+ * @return unsigned
+ */
+unsigned Collision::GetContactCount() { return collision->contacts.size(); }
+
+/**
+ * @brief Packs the position and radius of every object with Physics and a
+ *        Transform into arrays
+ *
+ */
+void Collision::Pack() {
+    entities.clear();
+    objects.clear();
+    positions.clear();
+    radii.clear();
+
+    const Transform_Data& transforms = Component_Storage::GetTransformData();
+    Component_Storage::ForEach<Physics, Transform>([&](unsigned i, Physics& physics, Transform&) {
+        glm::vec3 scale = glm::abs(transforms.scale[i]);
+        entities.emplace_back(i);
+        objects.emplace_back(physics.GetParent());
+        positions.emplace_back(transforms.position[i]);
+        radii.emplace_back(std::max(scale.x, std::max(scale.y, scale.z)));
+    });
+
+    isRemoved.assign(positions.size(), 0);
+}
+
+/**
+ * @brief Finds touching pairs using a uniform grid hashed into buckets. Cells
+ *        are twice the largest radius, so only the 27 cells around a body can
+ *        hold bodies touching it
+ *
+ */
+void Collision::FindGridPairs() {
+    unsigned count = positions.size();
+    Real cellSize = Real(2) * *std::max_element(radii.begin(), radii.end());
+    if (cellSize <= Real(0)) return;
+
+    grid.Build(positions, cellSize);
+
+    Job_System::ParallelFor(count, 256, [this](unsigned begin, unsigned end) {
+        std::vector<Contact>& found = threadContacts[Job_System::GetThreadIndex()];
+        for (unsigned a = begin; a < end; ++a) {
+            grid.ForEachNear(a, [this, a, &found](unsigned b) {
+                if (b > a) Test(a, b, found);
+            });
+        }
+    });
+}
+
+/**
+ * @brief Finds touching pairs by sorting the bodies by their left edge and
+ *        only testing bodies whose edges overlap along x. Works with bodies of
+ *        any size
+ *
+ */
+void Collision::FindSweepPairs() {
+    unsigned count = positions.size();
+    sortedBodies.resize(count);
+    std::iota(sortedBodies.begin(), sortedBodies.end(), 0u);
+    std::sort(sortedBodies.begin(), sortedBodies.end(), [this](unsigned left, unsigned right) {
+        return positions[left].x - radii[left] < positions[right].x - radii[right];
+    });
+
+    Job_System::ParallelFor(count, 256, [this, count](unsigned begin, unsigned end) {
+        std::vector<Contact>& found = threadContacts[Job_System::GetThreadIndex()];
+        for (unsigned k = begin; k < end; ++k) {
+            unsigned a = sortedBodies[k];
+            Real right = positions[a].x + radii[a];
+
+              // Bodies after this one that start past its right edge can't touch it
+            for (unsigned m = k + 1; m < count; ++m) {
+                unsigned b = sortedBodies[m];
+                if (positions[b].x - radii[b] > right) break;
+                Test(std::min(a, b), std::max(a, b), found);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Finds touching pairs from the neighbor lists, which are only built
+ *        again once a body has moved far enough. Uses the grid when the preset
+ *        has no neighbor lists, or when the lists are too short to hold every
+ *        touching pair
+ *
+ */
+void Collision::FindNeighborPairs() {
+    if (!Neighbor_List::IsEnabled()) {
+        FindGridPairs();
+        return;
+    }
+
+      // Bodies can close the skin between builds, so only pairs closer than
+      // the cutoff are sure to be listed, and touching pairs can be up to two
+      // of the largest radii apart
+    if (Neighbor_List::GetCutoff() < Real(2) * *std::max_element(radii.begin(), radii.end())) {
+        if (!hasShortLists) {
+            Trace::Message("Neighbor cutoff is shorter than the largest body is wide, using the grid for collisions.\n");
+            hasShortLists = true;
+        }
+        FindGridPairs();
+        return;
+    }
+
+      // Bodies have moved since the start of the step
+    Neighbor_List::Update();
+
+    unsigned count = positions.size();
+    bodies.assign(Component_Storage::GetEntityCount(), -1);
+    for (unsigned body = 0; body < count; ++body) bodies[entities[body]] = int(body);
+
+    Job_System::ParallelFor(count, 256, [this](unsigned begin, unsigned end) {
+        std::vector<Contact>& found = threadContacts[Job_System::GetThreadIndex()];
+        for (unsigned a = begin; a < end; ++a) {
+            unsigned neighborCount;
+            const unsigned* neighbors = Neighbor_List::GetNeighbors(entities[a], neighborCount);
+            for (unsigned k = 0; k < neighborCount; ++k) {
+                int b = bodies[neighbors[k]];
+                if (b > int(a)) Test(a, unsigned(b), found);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Adds a contact for the pair if their spheres overlap
+ *
+ * @param a First body
+ * @param b Second body
+ * @param found Contacts of the calling thread
+ */
+void Collision::Test(unsigned a, unsigned b, std::vector<Contact>& found) const {
+    Vec3 offset = positions[b] - positions[a];
+    Real distanceSq = glm::dot(offset, offset);
+    Real radiusSum = radii[a] + radii[b];
+    if (distanceSq >= radiusSum * radiusSum) return;
+
+    Real distance = std::sqrt(distanceSq);
+    Vec3 normal = distance > Real(0) ? offset / distance : Vec3(1, 0, 0);
+    found.push_back({ a, b, normal, radiusSum - distance });
+}
+
+/**
+ * @brief Bounces the pair apart with an impulse along the contact normal and
+ *        moves them so they no longer overlap (heavier bodies move less)
+ *
+ * @param contact
+ */
+void Collision::Resolve(const Contact& contact) {
+    Physics_Data& physics = Component_Storage::GetPhysicsData();
+    Transform_Data& transforms = Component_Storage::GetTransformData();
+    unsigned entityA = entities[contact.a];
+    unsigned entityB = entities[contact.b];
+
+      // Sleeping bodies resting on each other stay asleep
+    if (physics.isSleeping[entityA] && physics.isSleeping[entityB]) return;
+
+    Real inverseMassA = physics.mass[entityA] > Real(0) ? Real(1) / physics.mass[entityA] : Real(0);
+    Real inverseMassB = physics.mass[entityB] > Real(0) ? Real(1) / physics.mass[entityB] : Real(0);
+    Real inverseMassSum = inverseMassA + inverseMassB;
+    if (inverseMassSum <= Real(0)) return;
+
+      // Every body that can be pushed is moved below (and maybe bounced), so
+      // a sleeping one has to be stepped again
+    if (inverseMassA > Real(0)) Wake(physics, entityA);
+    if (inverseMassB > Real(0)) Wake(physics, entityB);
+    Gravity::MarkChanged();
+
+      // Impulse, only when the bodies are moving towards each other
+    Real closingSpeed = glm::dot(physics.velocity[entityB] - physics.velocity[entityA], contact.normal);
+    if (closingSpeed < Real(0)) {
+        Real impulse = -(Real(1) + restitution) * closingSpeed / inverseMassSum;
+        physics.velocity[entityA] -= contact.normal * (impulse * inverseMassA);
+        physics.velocity[entityB] += contact.normal * (impulse * inverseMassB);
+    }
+
+      // Separating the spheres
+    Vec3 correction = contact.normal * (contact.depth / inverseMassSum);
+    positions[contact.a] -= correction * inverseMassA;
+    positions[contact.b] += correction * inverseMassB;
+    transforms.position[entityA] = positions[contact.a];
+    transforms.position[entityB] = positions[contact.b];
+    transforms.isDirty[entityA] = 1;
+    transforms.isDirty[entityB] = 1;
+}
+
+/**
+ * @brief Merges the lighter body into the heavier one. Mass and momentum are
+ *        kept, the new body sits at the center of mass and has the volume of
+ *        both. The lighter object is destroyed once the step is over
+ *
+ * @param contact
+ */
+void Collision::Merge(const Contact& contact) {
+    Physics_Data& physics = Component_Storage::GetPhysicsData();
+    Transform_Data& transforms = Component_Storage::GetTransformData();
+
+    unsigned kept = contact.a, lost = contact.b;
+    if (physics.mass[entities[lost]] > physics.mass[entities[kept]]) std::swap(kept, lost);
+    unsigned entityKept = entities[kept];
+    unsigned entityLost = entities[lost];
+
+    Real massKept = physics.mass[entityKept];
+    Real massLost = physics.mass[entityLost];
+    Real totalMass = massKept + massLost;
+    if (totalMass <= Real(0)) return;
+
+    physics.velocity[entityKept] = (physics.velocity[entityKept] * massKept + physics.velocity[entityLost] * massLost) / totalMass;
+    physics.mass[entityKept] = totalMass;
+    Wake(physics, entityKept);
+    Gravity::MarkChanged();
+
+    positions[kept] = (positions[kept] * massKept + positions[lost] * massLost) / totalMass;
+    transforms.position[entityKept] = positions[kept];
+
+      // Growing so the volume is the sum of both spheres
+    Real growth = Real(1);
+    if (radii[kept] > Real(0)) {
+        Real ratio = radii[lost] / radii[kept];
+        growth = std::cbrt(Real(1) + ratio * ratio * ratio);
+    }
+    radii[kept] *= growth;
+    transforms.scale[entityKept] *= float(growth);
+    transforms.isDirty[entityKept] = 1;
+
+    isRemoved[lost] = 1;
+    Command_Buffer::DestroyObject(objects[lost]->GetId());
+}
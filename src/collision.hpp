@@ -0,0 +1,87 @@
+/**
+ * @file collision.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-14
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef COLLISION_HPP
+#define COLLISION_HPP
+
+// std includes //
+#include <vector>
+
+// Library includes //
+#include <vec3.hpp>
+
+// Engine includes //
+#include "file_reader.hpp"
+#include "file_writer.hpp"
+#include "hash_grid.hpp"
+#include "object.hpp"
+#include "precision.hpp"
+
+/*! Collision class (finds touching spheres and pushes them apart or merges them) */
+class Collision {
+    public:
+        /*! Way the pairs of bodies that may touch are found */
+        enum Broadphase {
+            None,      //!< No collisions
+            Grid,      //!< Uniform spatial hash (bodies of similar size)
+            Sweep,     //!< Sweep and prune along x (bodies of mixed sizes)
+            Neighbors, //!< Neighbor lists kept across steps (cutoff at least the largest diameter)
+            BroadphaseCount
+        };
+
+        static const char* broadphaseNames[BroadphaseCount]; //!< Name of each broadphase (used in presets)
+
+        static bool Initialize(File_Reader& preset);
+        static bool Initialize();
+        static void Update();
+        static void Shutdown();
+        static void Write(File_Writer& writer);
+
+        static Broadphase GetBroadphase();
+        static void SetBroadphase(Broadphase broadphase_);
+        static float& GetRestitution();
+        static bool& GetMerge();
+        static unsigned GetContactCount();
+    private:
+        /*! Pair of bodies that touch */
+        struct Contact {
+            unsigned a;       //!< First body (lower index)
+            unsigned b;       //!< Second body
+            Vec3 normal;      //!< Direction from a to b
+            Real depth;       //!< How far the spheres overlap
+        };
+
+        void Pack();
+        void FindGridPairs();
+        void FindSweepPairs();
+        void FindNeighborPairs();
+        void Test(unsigned a, unsigned b, std::vector<Contact>& found) const;
+        void Resolve(const Contact& contact);
+        void Merge(const Contact& contact);
+    private:
+        std::vector<unsigned> entities;                   //!< Entity of each body this step
+        std::vector<Object*> objects;                     //!< Object of each body this step
+        std::vector<Vec3> positions;                      //!< Position of each body this step
+        std::vector<Real> radii;                          //!< Radius of each body (largest scale axis)
+        std::vector<int> bodies;                          //!< Body of each entity this step (neighbors, -1 if none)
+        std::vector<unsigned char> isRemoved;             //!< Whether the body was merged into another this step
+        std::vector<unsigned> sortedBodies;               //!< Bodies sorted by their left edge (sweep)
+        Hash_Grid grid;                                   //!< Bodies hashed into cells (grid)
+        std::vector<std::vector<Contact>> threadContacts; //!< Contacts found by each thread
+        std::vector<Contact> contacts;                    //!< Every contact this step
+        Broadphase broadphase;                            //!< Broadphase being used
+        float restitution;                                //!< Bounciness of collisions (0 sticks, 1 elastic)
+        bool merge;                                       //!< Whether touching bodies merge instead of bouncing
+        bool hasShortLists;                               //!< Whether the neighbor lists were found too short (logged once)
+};
+
+#endif
@@ -0,0 +1,186 @@
+/**
+ * @file command_buffer.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-12
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// std includes //
+#include <algorithm>
+
+// Engine includes //
+#include "command_buffer.hpp"
+#include "gravity.hpp"
+#include "object_manager.hpp"
+#include "trace.hpp"
+
+static Command_Buffer* command_buffer = nullptr; //!< Command_Buffer object
+
+/**
+ * @brief Initializes the command buffer
+ *
+ * @return true
+ * @return false
+ */
+bool Command_Buffer::Initialize() {
+      // Initializing command_buffer
+    command_buffer = new Command_Buffer;
+    if (!command_buffer) {
+        Trace::Message("Command Buffer was not initialized.\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Throws away any commands that weren't applied and deletes the command
+ *        buffer
+ *
+ * @return void
+ */
+void Command_Buffer::Shutdown() {
+    if (!command_buffer) return;
+
+    Clear();
+
+    delete command_buffer;
+    command_buffer = nullptr;
+}
+
+/**
+ * @brief Adds the object to the object manager at the next Apply. The id of the
+ *        object is given out then, and its components are left out of the
+ *        systems until then
+ *
+ * @param object Object that isn't in the object manager yet
+ * @return void
+ */
+void Command_Buffer::CreateObject(Object* object) {
+    if (!object) return;
+
+    std::lock_guard<std::mutex> guard(command_buffer->lock);
+    command_buffer->creates.emplace_back(object);
+}
+
+/**
+ * @brief Removes the object at the next Apply
+ *
+ * @param id
+ * @return void
+ */
+void Command_Buffer::DestroyObject(int id) {
+    if (id < 0) return;
+
+    std::lock_guard<std::mutex> guard(command_buffer->lock);
+    command_buffer->destroys.emplace_back(id);
+}
+
+/**
+ * @brief Attaches the component to the object at the next Apply (the component
+ *        is deleted if the object is gone by then)
+ *
+ * @param id
+ * @param component
+ * @return void
+ */
+void Command_Buffer::AddComponent(int id, Component* component) {
+    if (!component) return;
+
+    std::lock_guard<std::mutex> guard(command_buffer->lock);
+    command_buffer->componentAdds.emplace_back(Component_Add{ id, component });
+}
+
+/**
+ * @brief Removes the object's component of the given type at the next Apply
+ *
+ * @param id
+ * @param type
+ * @return void
+ */
+void Command_Buffer::RemoveComponent(int id, CType type) {
+    std::lock_guard<std::mutex> guard(command_buffer->lock);
+    command_buffer->componentRemoves.emplace_back(Component_Remove{ id, type });
+}
+
+/**
+ * @brief Makes every recorded change. Called between fixed steps, when nothing
+ *        is walking the object list. Repeated commands are only done once
+ *
+ * @return void
+ */
+void Command_Buffer::Apply() {
+    std::lock_guard<std::mutex> guard(command_buffer->lock);
+
+      // Adding or removing bodies changes the pull on every other body
+    if (!command_buffer->destroys.empty() || !command_buffer->creates.empty() ||
+        !command_buffer->componentAdds.empty() || !command_buffer->componentRemoves.empty()) Gravity::MarkChanged();
+
+      // Removing objects (sorted so each id is only removed once)
+    std::vector<int>& destroys = command_buffer->destroys;
+    std::sort(destroys.begin(), destroys.end());
+    destroys.erase(std::unique(destroys.begin(), destroys.end()), destroys.end());
+    for (int id : destroys) {
+        Object_Manager::RemoveObject(id);
+    }
+    destroys.clear();
+
+      // Removing components
+    std::vector<Component_Remove>& componentRemoves = command_buffer->componentRemoves;
+    std::sort(componentRemoves.begin(), componentRemoves.end(), [](const Component_Remove& a, const Component_Remove& b) {
+        return a.id != b.id ? a.id < b.id : a.type < b.type;
+    });
+    for (unsigned i = 0; i < componentRemoves.size(); ++i) {
+        if (i > 0 && componentRemoves[i].id == componentRemoves[i - 1].id && 
+            componentRemoves[i].type == componentRemoves[i - 1].type) continue;
+
+        Object* object = Object_Manager::FindObject(componentRemoves[i].id);
+        if (object) object->RemoveComponent(componentRemoves[i].type);
+    }
+    componentRemoves.clear();
+
+      // Adding components (objects that are gone or already have one of that
+      // type don't take it)
+    for (Component_Add& add : command_buffer->componentAdds) {
+        Object* object = Object_Manager::FindObject(add.id);
+        if (!object || object->HasComponent(add.component->GetCType())) {
+            delete add.component;
+            continue;
+        }
+        object->AddComponent(add.component);
+    }
+    command_buffer->componentAdds.clear();
+
+      // Adding new objects
+    Object_Manager::Reserve(command_buffer->creates.size());
+    for (Object* object : command_buffer->creates) {
+        if (!Object_Manager::AddObject(object)) delete object;
+    }
+    command_buffer->creates.clear();
+}
+
+/**
+ * @brief Throws away every recorded change (used when the objects are reset)
+ *
+ * @return void
+ */
+void Command_Buffer::Clear() {
+    if (!command_buffer) return;
+    std::lock_guard<std::mutex> guard(command_buffer->lock);
+
+    for (Object* object : command_buffer->creates) {
+        delete object;
+    }
+    for (Component_Add& add : command_buffer->componentAdds) {
+        delete add.component;
+    }
+
+    command_buffer->creates.clear();
+    command_buffer->destroys.clear();
+    command_buffer->componentAdds.clear();
+    command_buffer->componentRemoves.clear();
+}
@@ -0,0 +1,57 @@
+/**
+ * @file command_buffer.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-12
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef COMMAND_BUFFER_HPP
+#define COMMAND_BUFFER_HPP
+
+// std includes //
+#include <mutex>
+#include <vector>
+
+// Engine includes //
+#include "component.hpp"
+#include "object.hpp"
+
+/*! Command_Buffer class (changes to the object list that wait for Apply) */
+class Command_Buffer {
+    public:
+        static bool Initialize();
+        static void Shutdown();
+
+        static void CreateObject(Object* object);
+        static void DestroyObject(int id);
+        static void AddComponent(int id, Component* component);
+        static void RemoveComponent(int id, CType type);
+
+        static void Apply();
+        static void Clear();
+    private:
+        /*! Component being added to an object */
+        struct Component_Add {
+            int id;               //!< Object getting the component
+            Component* component; //!< Component to add
+        };
+
+        /*! Component being taken off of an object */
+        struct Component_Remove {
+            int id;     //!< Object losing the component
+            CType type; //!< Type of component to remove
+        };
+    private:
+        std::vector<Object*> creates;                   //!< Objects waiting to be added
+        std::vector<int> destroys;                      //!< Ids of objects waiting to be removed
+        std::vector<Component_Add> componentAdds;       //!< Components waiting to be added
+        std::vector<Component_Remove> componentRemoves; //!< Components waiting to be removed
+        std::mutex lock;                                //!< Lets commands be recorded from any thread
+};
+
+#endif
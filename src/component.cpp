@@ -11,20 +11,56 @@
 
 // Engine includes //
 #include "component.hpp"
+#include "component_storage.hpp"
+#include "object.hpp"
 
 /**
  * @brief Creates a new component of given type
  * 
  * @param type_ Type of component
  */
-Component::Component(CType type_) : type(type_) {}
+Component::Component(CType type_) : type(type_), parent(nullptr) {}
 
 /**
- * @brief Sets the parent of the component
+ * @brief Copy constructor. The copy isn't attached to any object
+ * 
+ * @param other 
+ */
+Component::Component(const Component& other) : type(other.type), parent(nullptr) {}
+
+/**
+ * @brief Copies the type of the other component. Stays attached to the same
+ *        object
+ * 
+ * @param other 
+ * @return Component& 
+ */
+Component& Component::operator=(const Component& other) {
+    type = other.type;
+    return *this;
+}
+
+/**
+ * @brief Lets derived components clean up when deleted through a Component*.
+ *        Takes the component out of its object's entity
+ * 
+ */
+Component::~Component() {
+    if (parent) Component_Storage::SetComponent(type, parent->GetEntity(), nullptr);
+}
+
+/**
+ * @brief Sets the parent of the component. The component is stored at the
+ *        parent's entity so systems can find it with Component_Storage::ForEach,
+ *        once the parent is in the Object_Manager (see Object::StoreComponents)
  * 
  * @param object The object that is the parent
  */
-void Component::SetParent(Object* object) { parent = object; }
+void Component::SetParent(Object* object) {
+    if (parent) Component_Storage::SetComponent(type, parent->GetEntity(), nullptr);
+    parent = object;
+    if (parent && parent->GetId() != -1) Component_Storage::SetComponent(type, parent->GetEntity(), this);
+}
 
 /**
  * @brief Gets the parent of the component
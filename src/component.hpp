@@ -13,23 +13,71 @@
 #ifndef COMPONENT_HPP
 #define COMPONENT_HPP
 
+// std includes //
+#include <type_traits>
+
 // Defining object class
 class Object;
 
+// Defining component classes
+class Behavior;
+class Model;
+class Physics;
+class Transform;
+
+/*! Type_List class (the position of a type in the list is its index) */
+template <typename... Ts>
+struct Type_List {
+    static constexpr unsigned count = sizeof...(Ts); //!< Number of types in the list
+
+    /**
+     * @brief Returns the position of T in the list (count if it isn't in it)
+     * 
+     * @tparam T 
+     * @return unsigned 
+     */
+    template <typename T>
+    static constexpr unsigned IndexOf() {
+        unsigned index = 0;
+        bool matches[] = { std::is_same<T, Ts>::value... };
+        for (bool match : matches) {
+            if (match) return index;
+            ++index;
+        }
+        return index;
+    }
+};
+
+  // Every component type (new components are added here)
+typedef Type_List<Behavior, Model, Physics, Transform> Component_Types;
+
 /*! Component class */
 class Component {
     public:
-        /*! Types of components */
-        enum CType {
-            CBehavior,
-            CModel,
-            CPhysics,
-            CTransform,
-        };
+        typedef unsigned CType; //!< Type of component (index in Component_Types)
+
+        /**
+         * @brief Returns the type of the component class T
+         * 
+         * @tparam T 
+         * @return CType 
+         */
+        template <typename T>
+        static constexpr CType TypeOf() {
+            static_assert(Component_Types::IndexOf<T>() < Component_Types::count, "Not in Component_Types");
+            return Component_Types::IndexOf<T>();
+        }
+
+        static constexpr CType typeCount = Component_Types::count; //!< Number of component types
 
         Component(CType type_);
+        Component(const Component& other);
+        Component& operator=(const Component& other);
+        virtual ~Component();
+
+        virtual Component* Clone() const = 0;
 
-        void SetParent(Object* object);
+        virtual void SetParent(Object* object);
         Object* GetParent() const;
 
         CType GetCType() const;
@@ -0,0 +1,215 @@
+/**
+ * @file component_storage.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-09
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// Engine includes //
+#include "component_storage.hpp"
+#include "trace.hpp"
+
+static Component_Storage* component_storage = nullptr; //!< Component_Storage object
+
+/**
+ * @brief Initializes the component storage
+ *
+ * @return true
+ * @return false
+ */
+bool Component_Storage::Initialize() {
+      // Initializing component_storage
+    component_storage = new Component_Storage;
+    if (!component_storage) {
+        Trace::Message("Component Storage was not initialized.\n");
+        return false;
+    }
+
+    component_storage->entityCount = 0;
+    component_storage->Resize(0);
+
+    return true;
+}
+
+/**
+ * @brief Deletes the component storage and all of the data in it
+ *
+ * @return void
+ */
+void Component_Storage::Shutdown() {
+    if (!component_storage) return;
+
+    delete component_storage;
+    component_storage = nullptr;
+}
+
+/**
+ * @brief Gives out an entity (index into the component arrays). Released
+ *        entities are reused first so the arrays stay dense
+ *
+ * @return unsigned
+ */
+unsigned Component_Storage::CreateEntity() {
+    if (!component_storage->freeEntities.empty()) {
+        unsigned entity = component_storage->freeEntities.back();
+        component_storage->freeEntities.pop_back();
+        return entity;
+    }
+
+    unsigned entity = component_storage->entityCount++;
+    component_storage->Resize(component_storage->entityCount);
+    return entity;
+}
+
+/**
+ * @brief Gives an entity back so it can be reused
+ *
+ * @param entity
+ * @return void
+ */
+void Component_Storage::ReleaseEntity(unsigned entity) {
+    if (!component_storage) return;
+
+    component_storage->transforms.isUsed[entity] = 0;
+    component_storage->physics.isUsed[entity] = 0;
+    for (std::vector<Component*>& array : component_storage->components) {
+        array[entity] = nullptr;
+    }
+    component_storage->freeEntities.emplace_back(entity);
+}
+
+/**
+ * @brief Returns the size of the component arrays (loops over entities go
+ *        from 0 to this and skip unused entries)
+ *
+ * @return unsigned
+ */
+unsigned Component_Storage::GetEntityCount() { return component_storage->entityCount; }
+
+/**
+ * @brief Makes room in every array for the given number of entities, so
+ *        creating many entities in a row doesn't move the arrays each time
+ *
+ * @param count Total number of entities to make room for
+ * @return void
+ */
+void Component_Storage::Reserve(unsigned count) {
+    Transform_Data& transforms = component_storage->transforms;
+    transforms.position.reserve(count);
+    transforms.oldPosition.reserve(count);
+    transforms.scale.reserve(count);
+    transforms.rotation.reserve(count);
+    transforms.oldRotation.reserve(count);
+    transforms.startPosition.reserve(count);
+    transforms.matrix.reserve(count);
+    transforms.isDirty.reserve(count);
+    transforms.renderMatrix.reserve(count);
+    transforms.isStepped.reserve(count);
+    transforms.isUsed.reserve(count);
+
+    Physics_Data& physics = component_storage->physics;
+    physics.acceleration.reserve(count);
+    physics.forces.reserve(count);
+    physics.heldForces.reserve(count);
+    physics.velocity.reserve(count);
+    physics.initialVelocity.reserve(count);
+    physics.initialAcceleration.reserve(count);
+    physics.rotationalVelocity.reserve(count);
+    physics.mass.reserve(count);
+    physics.usesGravity.reserve(count);
+    physics.restTime.reserve(count);
+    physics.isSleeping.reserve(count);
+    physics.blockLevel.reserve(count);
+    physics.blockGravity.reserve(count);
+    physics.endGravity.reserve(count);
+    physics.hasEndGravity.reserve(count);
+    physics.isUsed.reserve(count);
+
+    for (std::vector<Component*>& array : component_storage->components) {
+        array.reserve(count);
+    }
+}
+
+/**
+ * @brief Returns the data of every Transform component. References into it are
+ *        only valid until a new entity is created
+ *
+ * @return Transform_Data&
+ */
+Transform_Data& Component_Storage::GetTransformData() { return component_storage->transforms; }
+
+/**
+ * @brief Returns the data of every Physics component. References into it are
+ *        only valid until a new entity is created
+ *
+ * @return Physics_Data&
+ */
+Physics_Data& Component_Storage::GetPhysicsData() { return component_storage->physics; }
+
+/**
+ * @brief Sets the component of the given type attached to the entity (nullptr
+ *        when it is taken off)
+ *
+ * @param type Type of the component
+ * @param entity
+ * @param component
+ * @return void
+ */
+void Component_Storage::SetComponent(CType type, unsigned entity, Component* component) {
+    if (!component_storage) return;
+    component_storage->components[type][entity] = component;
+}
+
+/**
+ * @brief Returns the attached components of the given type (index is the entity)
+ *
+ * @param type
+ * @return std::vector<Component*>&
+ */
+std::vector<Component*>& Component_Storage::GetComponents(CType type) {
+    return component_storage->components[type];
+}
+
+/**
+ * @brief Resizes every array to fit the given number of entities
+ *
+ * @param count
+ */
+void Component_Storage::Resize(unsigned count) {
+    transforms.position.resize(count, Vec3(0));
+    transforms.oldPosition.resize(count, Vec3(0));
+    transforms.scale.resize(count, glm::vec3(1.f));
+    transforms.rotation.resize(count, glm::vec3(0.f));
+    transforms.oldRotation.resize(count, glm::vec3(0.f));
+    transforms.startPosition.resize(count, Vec3(0));
+    transforms.matrix.resize(count, glm::mat4(1.f));
+    transforms.isDirty.resize(count, 1);
+    transforms.renderMatrix.resize(count, glm::mat4(1.f));
+    transforms.isStepped.resize(count, 0);
+    transforms.isUsed.resize(count, 0);
+
+    physics.acceleration.resize(count, Vec3(0));
+    physics.forces.resize(count, Vec3(0));
+    physics.heldForces.resize(count, Vec3(0));
+    physics.velocity.resize(count, Vec3(0));
+    physics.initialVelocity.resize(count, Vec3(0));
+    physics.initialAcceleration.resize(count, Vec3(0));
+    physics.rotationalVelocity.resize(count, glm::vec3(0.f));
+    physics.mass.resize(count, Real(1));
+    physics.usesGravity.resize(count, 0);
+    physics.restTime.resize(count, 0.f);
+    physics.isSleeping.resize(count, 0);
+    physics.blockLevel.resize(count, Physics_Data::noBlock);
+    physics.blockGravity.resize(count, Vec3(0));
+    physics.endGravity.resize(count, Vec3(0));
+    physics.hasEndGravity.resize(count, 0);
+    physics.isUsed.resize(count, 0);
+
+    for (std::vector<Component*>& array : components) {
+        array.resize(count, nullptr);
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * @file component_storage.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-09
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef COMPONENT_STORAGE_HPP
+#define COMPONENT_STORAGE_HPP
+
+// std includes //
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Library includes //
+#include <mat4x4.hpp>
+#include <vec3.hpp>
+
+// Engine includes //
+#include "component.hpp"
+#include "precision.hpp"
+
+static const std::size_t cacheLineSize = 64; //!< Alignment of the component arrays
+
+/*! Aligned_Allocator class (keeps the start of each array on a cache line) */
+template <typename T>
+class Aligned_Allocator {
+    public:
+        typedef T value_type;
+
+        Aligned_Allocator() {}
+        template <typename U>
+        Aligned_Allocator(const Aligned_Allocator<U>&) {}
+
+        /**
+         * @brief Allocates room for count objects on a cache line boundary
+         *
+         * @param count
+         * @return T*
+         */
+        T* allocate(std::size_t count) {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(cacheLineSize)));
+        }
+
+        /**
+         * @brief Frees memory given by allocate
+         *
+         * @param pointer
+         */
+        void deallocate(T* pointer, std::size_t) {
+            ::operator delete(pointer, std::align_val_t(cacheLineSize));
+        }
+
+        template <typename U>
+        bool operator==(const Aligned_Allocator<U>&) const { return true; }
+        template <typename U>
+        bool operator!=(const Aligned_Allocator<U>&) const { return false; }
+};
+
+template <typename T>
+using Aligned_Vector = std::vector<T, Aligned_Allocator<T>>; //!< Cache aligned array
+
+/*! Transform data of every entity (index is the entity) */
+struct Transform_Data {
+    Aligned_Vector<Vec3> position;           //!< Position of object
+    Aligned_Vector<Vec3> oldPosition;        //!< Previous position of object
+    Aligned_Vector<glm::vec3> scale;         //!< Scale of object
+    Aligned_Vector<glm::vec3> rotation;      //!< Rotation of object
+    Aligned_Vector<glm::vec3> oldRotation;   //!< Previous rotation of object
+    Aligned_Vector<Vec3> startPosition;      //!< Starting position of the object
+    Aligned_Vector<glm::mat4> matrix;        //!< World matrix (only up to date when isDirty is 0)
+    Aligned_Vector<unsigned char> isDirty;   //!< Whether position, rotation or scale changed since matrix was made
+    Aligned_Vector<glm::mat4> renderMatrix;  //!< Matrix the object is drawn with (blended between steps)
+    Aligned_Vector<unsigned char> isStepped; //!< Whether the Integrator moved it in the last step (only those are blended)
+    Aligned_Vector<unsigned char> isUsed;    //!< Whether the entity has a Transform
+};
+
+/*! Physics data of every entity (index is the entity) */
+struct Physics_Data {
+    static constexpr unsigned char noBlock = 255;      //!< blockLevel of a body not in a block (block integrator)
+
+    Aligned_Vector<Vec3> acceleration;             //!< Acceleration of object
+    Aligned_Vector<Vec3> forces;                   //!< Forces acting on object (reset at end of each update)
+    Aligned_Vector<Vec3> heldForces;               //!< Forces held for the last step it took (the same forces don't wake it)
+    Aligned_Vector<Vec3> velocity;                 //!< Velocity of object
+    Aligned_Vector<Vec3> initialVelocity;          //!< Starting velocity
+    Aligned_Vector<Vec3> initialAcceleration;      //!< Starting acceleration
+    Aligned_Vector<glm::vec3> rotationalVelocity;  //!< How fast is the object rotating
+    Aligned_Vector<Real> mass;                     //!< Mass of object
+    Aligned_Vector<unsigned char> usesGravity;     //!< Whether the object is pulled by other bodies this step
+    Aligned_Vector<float> restTime;                //!< Seconds the object has barely moved for
+    Aligned_Vector<unsigned char> isSleeping;      //!< Whether the object is left out of physics steps
+    Aligned_Vector<unsigned char> blockLevel;      //!< Block step is dt times 2 to this (noBlock until one starts)
+    Aligned_Vector<Vec3> blockGravity;             //!< Pull of the other bodies at the start of the block
+    Aligned_Vector<Vec3> endGravity;               //!< Pull of the other bodies at the end of the last step (Verlet)
+    Aligned_Vector<unsigned char> hasEndGravity;   //!< Whether endGravity can open the next step (cleared when it sleeps or moves)
+    Aligned_Vector<unsigned char> isUsed;          //!< Whether the entity has a Physics
+};
+
+/*! Component_Storage class */
+class Component_Storage {
+    public:
+        static bool Initialize();
+        static void Shutdown();
+
+        static unsigned CreateEntity();
+        static void ReleaseEntity(unsigned entity);
+        static unsigned GetEntityCount();
+        static void Reserve(unsigned count);
+
+        static Transform_Data& GetTransformData();
+        static Physics_Data& GetPhysicsData();
+
+        static void SetComponent(CType type, unsigned entity, Component* component);
+
+        /**
+         * @brief Calls function(entity, T&...) for each entity in [begin, end)
+         *        that has every one of the given components attached. The
+         *        entity can be used to index the data arrays directly
+         *
+         * @tparam Ts Component classes the entities need
+         * @param begin First entity
+         * @param end One past the last entity
+         * @param function Called for each matching entity
+         */
+        template <typename... Ts, typename Function>
+        static void ForEach(unsigned begin, unsigned end, Function function) {
+            std::vector<Component*>* arrays[] = { &GetComponents(Ts::GetCType())... };
+            for (unsigned entity = begin; entity < end; ++entity) {
+                  // Skipping entities missing any of the components
+                bool hasAll = true;
+                for (std::vector<Component*>* array : arrays) {
+                    if (!(*array)[entity]) { hasAll = false; break; }
+                }
+                if (!hasAll) continue;
+
+                function(entity, *static_cast<Ts*>((*arrays[Type_List<Ts...>::template IndexOf<Ts>()])[entity])...);
+            }
+        }
+
+        /**
+         * @brief Calls function(entity, T&...) for every entity that has every
+         *        one of the given components attached
+         *
+         * @tparam Ts Component classes the entities need
+         * @param function Called for each matching entity
+         */
+        template <typename... Ts, typename Function>
+        static void ForEach(Function function) {
+            ForEach<Ts...>(0, GetEntityCount(), function);
+        }
+    private:
+        static std::vector<Component*>& GetComponents(CType type);
+
+        void Resize(unsigned count);
+    private:
+        Transform_Data transforms;                                //!< Data of every Transform component
+        Physics_Data physics;                                     //!< Data of every Physics component
+        std::vector<Component*> components[Component::typeCount]; //!< Attached component of each type for each entity
+        std::vector<unsigned> freeEntities;                       //!< Released entities that can be reused
+        unsigned entityCount;                                     //!< Number of entities ever handed out (array size)
+};
+
+#endif
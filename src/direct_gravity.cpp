@@ -0,0 +1,525 @@
+/**
+ * @file direct_gravity.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-04
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// std includes //
+#include <cmath>
+
+// Library includes //
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Engine includes //
+#include "direct_gravity.hpp"
+
+/**
+ * @brief Adds the interaction of the pair i, j to both bodies (Newton's third law)
+ *
+ */
+template <typename T>
+static inline void Pair(const T* posX, const T* posY, const T* posZ, const T* masses,
+    T* accelX, T* accelY, T* accelZ, unsigned i, unsigned j,
+    T& sumX, T& sumY, T& sumZ) {
+    T dx = posX[j] - posX[i];
+    T dy = posY[j] - posY[i];
+    T dz = posZ[j] - posZ[i];
+    T distanceSq = dx * dx + dy * dy + dz * dz;
+    if (distanceSq <= T(0)) return;
+    T invDistanceCubed = T(1) / (distanceSq * std::sqrt(distanceSq));
+
+      // Pull on i towards j
+    T strengthJ = masses[j] * invDistanceCubed;
+    sumX += dx * strengthJ;
+    sumY += dy * strengthJ;
+    sumZ += dz * strengthJ;
+
+      // Equal and opposite pull on j
+    T strengthI = masses[i] * invDistanceCubed;
+    accelX[j] -= dx * strengthI;
+    accelY[j] -= dy * strengthI;
+    accelZ[j] -= dz * strengthI;
+}
+
+/**
+ * @brief Adds the pull of body j on body i (i isn't changed)
+ *
+ */
+template <typename T>
+static inline void Pull(const T* posX, const T* posY, const T* posZ, const T* masses, unsigned i, unsigned j,
+    T& sumX, T& sumY, T& sumZ) {
+    T dx = posX[j] - posX[i];
+    T dy = posY[j] - posY[i];
+    T dz = posZ[j] - posZ[i];
+    T distanceSq = dx * dx + dy * dy + dz * dz;
+    if (distanceSq <= T(0)) return;
+    T strength = masses[j] / (distanceSq * std::sqrt(distanceSq));
+    sumX += dx * strength;
+    sumY += dy * strength;
+    sumZ += dz * strength;
+}
+
+#if defined(__AVX__)
+/**
+ * @brief Adds up the 8 floats of the register
+ *
+ */
+static inline float Sum(__m256 value) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+/**
+ * @brief Adds up the 4 doubles of the register
+ *
+ */
+static inline double Sum(__m256d value) {
+    __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1));
+    sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+    return _mm_cvtsd_f64(sum);
+}
+#elif defined(__SSE2__)
+/**
+ * @brief Adds up the 4 floats of the register
+ *
+ */
+static inline float Sum(__m128 value) {
+    __m128 sum = _mm_add_ps(value, _mm_movehl_ps(value, value));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+/**
+ * @brief Adds up the 2 doubles of the register
+ *
+ */
+static inline double Sum(__m128d value) {
+    return _mm_cvtsd_f64(_mm_add_sd(value, _mm_unpackhi_pd(value, value)));
+}
+#endif
+
+/**
+ * @brief Adds the gravitational acceleration (without the gravitational
+ *        constant) of the pairs (i, j) with begin <= i < end and j > i. Each
+ *        pair is applied to both bodies, so the work over [0, count) is half of
+ *        going body by body. The acceleration arrays are added to, not cleared
+ *
+ * @param posX Position of each body (x)
+ * @param posY Position of each body (y)
+ * @param posZ Position of each body (z)
+ * @param masses Mass of each body
+ * @param accelX Resulting acceleration (x)
+ * @param accelY Resulting acceleration (y)
+ * @param accelZ Resulting acceleration (z)
+ * @param begin First body whose pairs are added
+ * @param end One past the last body whose pairs are added
+ * @param count Number of bodies
+ */
+void Direct_Gravity::Compute(const float* posX, const float* posY, const float* posZ, const float* masses,
+    float* accelX, float* accelY, float* accelZ, unsigned begin, unsigned end, unsigned count) {
+    for (unsigned i = begin; i < end; ++i) {
+        float sumX = 0.f, sumY = 0.f, sumZ = 0.f;
+        unsigned j = i + 1;
+
+#if defined(__AVX__)
+          // 8 pairs at a time
+        const __m256 xi = _mm256_set1_ps(posX[i]);
+        const __m256 yi = _mm256_set1_ps(posY[i]);
+        const __m256 zi = _mm256_set1_ps(posZ[i]);
+        const __m256 mi = _mm256_set1_ps(masses[i]);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.f);
+        __m256 vSumX = zero, vSumY = zero, vSumZ = zero;
+
+        for (; j + 8 <= count; j += 8) {
+            __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(posX + j), xi);
+            __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(posY + j), yi);
+            __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(posZ + j), zi);
+            __m256 distanceSq = _mm256_add_ps(_mm256_mul_ps(dx, dx),
+                _mm256_add_ps(_mm256_mul_ps(dy, dy), _mm256_mul_ps(dz, dz)));
+
+              // Bodies in the same spot don't pull on each other
+            __m256 valid = _mm256_cmp_ps(distanceSq, zero, _CMP_GT_OQ);
+            __m256 invDistanceCubed = _mm256_and_ps(valid,
+                _mm256_div_ps(one, _mm256_mul_ps(distanceSq, _mm256_sqrt_ps(distanceSq))));
+
+            __m256 strengthJ = _mm256_mul_ps(_mm256_loadu_ps(masses + j), invDistanceCubed);
+            vSumX = _mm256_add_ps(vSumX, _mm256_mul_ps(dx, strengthJ));
+            vSumY = _mm256_add_ps(vSumY, _mm256_mul_ps(dy, strengthJ));
+            vSumZ = _mm256_add_ps(vSumZ, _mm256_mul_ps(dz, strengthJ));
+
+            __m256 strengthI = _mm256_mul_ps(mi, invDistanceCubed);
+            _mm256_storeu_ps(accelX + j, _mm256_sub_ps(_mm256_loadu_ps(accelX + j), _mm256_mul_ps(dx, strengthI)));
+            _mm256_storeu_ps(accelY + j, _mm256_sub_ps(_mm256_loadu_ps(accelY + j), _mm256_mul_ps(dy, strengthI)));
+            _mm256_storeu_ps(accelZ + j, _mm256_sub_ps(_mm256_loadu_ps(accelZ + j), _mm256_mul_ps(dz, strengthI)));
+        }
+
+        sumX = Sum(vSumX);
+        sumY = Sum(vSumY);
+        sumZ = Sum(vSumZ);
+#elif defined(__SSE2__)
+          // 4 pairs at a time
+        const __m128 xi = _mm_set1_ps(posX[i]);
+        const __m128 yi = _mm_set1_ps(posY[i]);
+        const __m128 zi = _mm_set1_ps(posZ[i]);
+        const __m128 mi = _mm_set1_ps(masses[i]);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.f);
+        __m128 vSumX = zero, vSumY = zero, vSumZ = zero;
+
+        for (; j + 4 <= count; j += 4) {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(posX + j), xi);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(posY + j), yi);
+            __m128 dz = _mm_sub_ps(_mm_loadu_ps(posZ + j), zi);
+            __m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_add_ps(_mm_mul_ps(dy, dy), _mm_mul_ps(dz, dz)));
+
+              // Bodies in the same spot don't pull on each other
+            __m128 valid = _mm_cmpgt_ps(distanceSq, zero);
+            __m128 invDistanceCubed = _mm_and_ps(valid,
+                _mm_div_ps(one, _mm_mul_ps(distanceSq, _mm_sqrt_ps(distanceSq))));
+
+            __m128 strengthJ = _mm_mul_ps(_mm_loadu_ps(masses + j), invDistanceCubed);
+            vSumX = _mm_add_ps(vSumX, _mm_mul_ps(dx, strengthJ));
+            vSumY = _mm_add_ps(vSumY, _mm_mul_ps(dy, strengthJ));
+            vSumZ = _mm_add_ps(vSumZ, _mm_mul_ps(dz, strengthJ));
+
+            __m128 strengthI = _mm_mul_ps(mi, invDistanceCubed);
+            _mm_storeu_ps(accelX + j, _mm_sub_ps(_mm_loadu_ps(accelX + j), _mm_mul_ps(dx, strengthI)));
+            _mm_storeu_ps(accelY + j, _mm_sub_ps(_mm_loadu_ps(accelY + j), _mm_mul_ps(dy, strengthI)));
+            _mm_storeu_ps(accelZ + j, _mm_sub_ps(_mm_loadu_ps(accelZ + j), _mm_mul_ps(dz, strengthI)));
+        }
+
+        sumX = Sum(vSumX);
+        sumY = Sum(vSumY);
+        sumZ = Sum(vSumZ);
+#endif
+
+          // Leftover pairs (or every pair without SIMD)
+        for (; j < count; ++j) {
+            Pair(posX, posY, posZ, masses, accelX, accelY, accelZ, i, j, sumX, sumY, sumZ);
+        }
+
+        accelX[i] += sumX;
+        accelY[i] += sumY;
+        accelZ[i] += sumZ;
+    }
+}
+
+/**
+ * @brief Same as the float version, for double precision builds. Registers
+ *        hold half as many lanes
+ *
+ * @param posX Position of each body (x)
+ * @param posY Position of each body (y)
+ * @param posZ Position of each body (z)
+ * @param masses Mass of each body
+ * @param accelX Resulting acceleration (x)
+ * @param accelY Resulting acceleration (y)
+ * @param accelZ Resulting acceleration (z)
+ * @param begin First body whose pairs are added
+ * @param end One past the last body whose pairs are added
+ * @param count Number of bodies
+ */
+void Direct_Gravity::Compute(const double* posX, const double* posY, const double* posZ, const double* masses,
+    double* accelX, double* accelY, double* accelZ, unsigned begin, unsigned end, unsigned count) {
+    for (unsigned i = begin; i < end; ++i) {
+        double sumX = 0.0, sumY = 0.0, sumZ = 0.0;
+        unsigned j = i + 1;
+
+#if defined(__AVX__)
+          // 4 pairs at a time
+        const __m256d xi = _mm256_set1_pd(posX[i]);
+        const __m256d yi = _mm256_set1_pd(posY[i]);
+        const __m256d zi = _mm256_set1_pd(posZ[i]);
+        const __m256d mi = _mm256_set1_pd(masses[i]);
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d one = _mm256_set1_pd(1.0);
+        __m256d vSumX = zero, vSumY = zero, vSumZ = zero;
+
+        for (; j + 4 <= count; j += 4) {
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(posX + j), xi);
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(posY + j), yi);
+            __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(posZ + j), zi);
+            __m256d distanceSq = _mm256_add_pd(_mm256_mul_pd(dx, dx),
+                _mm256_add_pd(_mm256_mul_pd(dy, dy), _mm256_mul_pd(dz, dz)));
+
+              // Bodies in the same spot don't pull on each other
+            __m256d valid = _mm256_cmp_pd(distanceSq, zero, _CMP_GT_OQ);
+            __m256d invDistanceCubed = _mm256_and_pd(valid,
+                _mm256_div_pd(one, _mm256_mul_pd(distanceSq, _mm256_sqrt_pd(distanceSq))));
+
+            __m256d strengthJ = _mm256_mul_pd(_mm256_loadu_pd(masses + j), invDistanceCubed);
+            vSumX = _mm256_add_pd(vSumX, _mm256_mul_pd(dx, strengthJ));
+            vSumY = _mm256_add_pd(vSumY, _mm256_mul_pd(dy, strengthJ));
+            vSumZ = _mm256_add_pd(vSumZ, _mm256_mul_pd(dz, strengthJ));
+
+            __m256d strengthI = _mm256_mul_pd(mi, invDistanceCubed);
+            _mm256_storeu_pd(accelX + j, _mm256_sub_pd(_mm256_loadu_pd(accelX + j), _mm256_mul_pd(dx, strengthI)));
+            _mm256_storeu_pd(accelY + j, _mm256_sub_pd(_mm256_loadu_pd(accelY + j), _mm256_mul_pd(dy, strengthI)));
+            _mm256_storeu_pd(accelZ + j, _mm256_sub_pd(_mm256_loadu_pd(accelZ + j), _mm256_mul_pd(dz, strengthI)));
+        }
+
+        sumX = Sum(vSumX);
+        sumY = Sum(vSumY);
+        sumZ = Sum(vSumZ);
+#elif defined(__SSE2__)
+          // 2 pairs at a time
+        const __m128d xi = _mm_set1_pd(posX[i]);
+        const __m128d yi = _mm_set1_pd(posY[i]);
+        const __m128d zi = _mm_set1_pd(posZ[i]);
+        const __m128d mi = _mm_set1_pd(masses[i]);
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d one = _mm_set1_pd(1.0);
+        __m128d vSumX = zero, vSumY = zero, vSumZ = zero;
+
+        for (; j + 2 <= count; j += 2) {
+            __m128d dx = _mm_sub_pd(_mm_loadu_pd(posX + j), xi);
+            __m128d dy = _mm_sub_pd(_mm_loadu_pd(posY + j), yi);
+            __m128d dz = _mm_sub_pd(_mm_loadu_pd(posZ + j), zi);
+            __m128d distanceSq = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_add_pd(_mm_mul_pd(dy, dy), _mm_mul_pd(dz, dz)));
+
+              // Bodies in the same spot don't pull on each other
+            __m128d valid = _mm_cmpgt_pd(distanceSq, zero);
+            __m128d invDistanceCubed = _mm_and_pd(valid,
+                _mm_div_pd(one, _mm_mul_pd(distanceSq, _mm_sqrt_pd(distanceSq))));
+
+            __m128d strengthJ = _mm_mul_pd(_mm_loadu_pd(masses + j), invDistanceCubed);
+            vSumX = _mm_add_pd(vSumX, _mm_mul_pd(dx, strengthJ));
+            vSumY = _mm_add_pd(vSumY, _mm_mul_pd(dy, strengthJ));
+            vSumZ = _mm_add_pd(vSumZ, _mm_mul_pd(dz, strengthJ));
+
+            __m128d strengthI = _mm_mul_pd(mi, invDistanceCubed);
+            _mm_storeu_pd(accelX + j, _mm_sub_pd(_mm_loadu_pd(accelX + j), _mm_mul_pd(dx, strengthI)));
+            _mm_storeu_pd(accelY + j, _mm_sub_pd(_mm_loadu_pd(accelY + j), _mm_mul_pd(dy, strengthI)));
+            _mm_storeu_pd(accelZ + j, _mm_sub_pd(_mm_loadu_pd(accelZ + j), _mm_mul_pd(dz, strengthI)));
+        }
+
+        sumX = Sum(vSumX);
+        sumY = Sum(vSumY);
+        sumZ = Sum(vSumZ);
+#endif
+
+          // Leftover pairs (or every pair without SIMD)
+        for (; j < count; ++j) {
+            Pair(posX, posY, posZ, masses, accelX, accelY, accelZ, i, j, sumX, sumY, sumZ);
+        }
+
+        accelX[i] += sumX;
+        accelY[i] += sumY;
+        accelZ[i] += sumZ;
+    }
+}
+
+/**
+ * @brief Sets the gravitational acceleration (without the gravitational
+ *        constant) of only the given bodies, from every body. Used when just
+ *        a few bodies need their pull (block timesteps), each target is only
+ *        written by the call that has it, so no per thread arrays are needed
+ *
+ * @param posX Position of each body (x)
+ * @param posY Position of each body (y)
+ * @param posZ Position of each body (z)
+ * @param masses Mass of each body
+ * @param accelX Resulting acceleration (x)
+ * @param accelY Resulting acceleration (y)
+ * @param accelZ Resulting acceleration (z)
+ * @param targets Bodies whose acceleration is found
+ * @param begin First index into targets
+ * @param end One past the last index into targets
+ * @param count Number of bodies
+ */
+void Direct_Gravity::ComputeFor(const float* posX, const float* posY, const float* posZ, const float* masses,
+    float* accelX, float* accelY, float* accelZ, const unsigned* targets, unsigned begin, unsigned end,
+    unsigned count) {
+    for (unsigned k = begin; k < end; ++k) {
+        const unsigned i = targets[k];
+        float sumX = 0.f, sumY = 0.f, sumZ = 0.f;
+        unsigned j = 0;
+
+#if defined(__AVX__)
+          // 8 bodies at a time, the body itself is at distance 0 so it's masked out
+        const __m256 xi = _mm256_set1_ps(posX[i]);
+        const __m256 yi = _mm256_set1_ps(posY[i]);
+        const __m256 zi = _mm256_set1_ps(posZ[i]);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.f);
+        __m256 vSumX = zero, vSumY = zero, vSumZ = zero;
+
+        for (; j + 8 <= count; j += 8) {
+            __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(posX + j), xi);
+            __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(posY + j), yi);
+            __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(posZ + j), zi);
+            __m256 distanceSq = _mm256_add_ps(_mm256_mul_ps(dx, dx),
+                _mm256_add_ps(_mm256_mul_ps(dy, dy), _mm256_mul_ps(dz, dz)));
+
+            __m256 valid = _mm256_cmp_ps(distanceSq, zero, _CMP_GT_OQ);
+            __m256 invDistanceCubed = _mm256_and_ps(valid,
+                _mm256_div_ps(one, _mm256_mul_ps(distanceSq, _mm256_sqrt_ps(distanceSq))));
+
+            __m256 strength = _mm256_mul_ps(_mm256_loadu_ps(masses + j), invDistanceCubed);
+            vSumX = _mm256_add_ps(vSumX, _mm256_mul_ps(dx, strength));
+            vSumY = _mm256_add_ps(vSumY, _mm256_mul_ps(dy, strength));
+            vSumZ = _mm256_add_ps(vSumZ, _mm256_mul_ps(dz, strength));
+        }
+
+        sumX = Sum(vSumX);
+        sumY = Sum(vSumY);
+        sumZ = Sum(vSumZ);
+#elif defined(__SSE2__)
+          // 4 bodies at a time, the body itself is at distance 0 so it's masked out
+        const __m128 xi = _mm_set1_ps(posX[i]);
+        const __m128 yi = _mm_set1_ps(posY[i]);
+        const __m128 zi = _mm_set1_ps(posZ[i]);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.f);
+        __m128 vSumX = zero, vSumY = zero, vSumZ = zero;
+
+        for (; j + 4 <= count; j += 4) {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(posX + j), xi);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(posY + j), yi);
+            __m128 dz = _mm_sub_ps(_mm_loadu_ps(posZ + j), zi);
+            __m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_add_ps(_mm_mul_ps(dy, dy), _mm_mul_ps(dz, dz)));
+
+            __m128 valid = _mm_cmpgt_ps(distanceSq, zero);
+            __m128 invDistanceCubed = _mm_and_ps(valid,
+                _mm_div_ps(one, _mm_mul_ps(distanceSq, _mm_sqrt_ps(distanceSq))));
+
+            __m128 strength = _mm_mul_ps(_mm_loadu_ps(masses + j), invDistanceCubed);
+            vSumX = _mm_add_ps(vSumX, _mm_mul_ps(dx, strength));
+            vSumY = _mm_add_ps(vSumY, _mm_mul_ps(dy, strength));
+            vSumZ = _mm_add_ps(vSumZ, _mm_mul_ps(dz, strength));
+        }
+
+        sumX = Sum(vSumX);
+        sumY = Sum(vSumY);
+        sumZ = Sum(vSumZ);
+#endif
+
+          // Leftover bodies (or every body without SIMD)
+        for (; j < count; ++j) {
+            Pull(posX, posY, posZ, masses, i, j, sumX, sumY, sumZ);
+        }
+
+        accelX[i] = sumX;
+        accelY[i] = sumY;
+        accelZ[i] = sumZ;
+    }
+}
+
+/**
+ * @brief Same as the float version, for double precision builds. Registers
+ *        hold half as many lanes
+ *
+ * @param posX Position of each body (x)
+ * @param posY Position of each body (y)
+ * @param posZ Position of each body (z)
+ * @param masses Mass of each body
+ * @param accelX Resulting acceleration (x)
+ * @param accelY Resulting acceleration (y)
+ * @param accelZ Resulting acceleration (z)
+ * @param targets Bodies whose acceleration is found
+ * @param begin First index into targets
+ * @param end One past the last index into targets
+ * @param count Number of bodies
+ */
+void Direct_Gravity::ComputeFor(const double* posX, const double* posY, const double* posZ, const double* masses,
+    double* accelX, double* accelY, double* accelZ, const unsigned* targets, unsigned begin, unsigned end,
+    unsigned count) {
+    for (unsigned k = begin; k < end; ++k) {
+        const unsigned i = targets[k];
+        double sumX = 0.0, sumY = 0.0, sumZ = 0.0;
+        unsigned j = 0;
+
+#if defined(__AVX__)
+          // 4 bodies at a time, the body itself is at distance 0 so it's masked out
+        const __m256d xi = _mm256_set1_pd(posX[i]);
+        const __m256d yi = _mm256_set1_pd(posY[i]);
+        const __m256d zi = _mm256_set1_pd(posZ[i]);
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d one = _mm256_set1_pd(1.0);
+        __m256d vSumX = zero, vSumY = zero, vSumZ = zero;
+
+        for (; j + 4 <= count; j += 4) {
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(posX + j), xi);
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(posY + j), yi);
+            __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(posZ + j), zi);
+            __m256d distanceSq = _mm256_add_pd(_mm256_mul_pd(dx, dx),
+                _mm256_add_pd(_mm256_mul_pd(dy, dy), _mm256_mul_pd(dz, dz)));
+
+            __m256d valid = _mm256_cmp_pd(distanceSq, zero, _CMP_GT_OQ);
+            __m256d invDistanceCubed = _mm256_and_pd(valid,
+                _mm256_div_pd(one, _mm256_mul_pd(distanceSq, _mm256_sqrt_pd(distanceSq))));
+
+            __m256d strength = _mm256_mul_pd(_mm256_loadu_pd(masses + j), invDistanceCubed);
+            vSumX = _mm256_add_pd(vSumX, _mm256_mul_pd(dx, strength));
+            vSumY = _mm256_add_pd(vSumY, _mm256_mul_pd(dy, strength));
+            vSumZ = _mm256_add_pd(vSumZ, _mm256_mul_pd(dz, strength));
+        }
+
+        sumX = Sum(vSumX);
+        sumY = Sum(vSumY);
+        sumZ = Sum(vSumZ);
+#elif defined(__SSE2__)
+          // 2 bodies at a time, the body itself is at distance 0 so it's masked out
+        const __m128d xi = _mm_set1_pd(posX[i]);
+        const __m128d yi = _mm_set1_pd(posY[i]);
+        const __m128d zi = _mm_set1_pd(posZ[i]);
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d one = _mm_set1_pd(1.0);
+        __m128d vSumX = zero, vSumY = zero, vSumZ = zero;
+
+        for (; j + 2 <= count; j += 2) {
+            __m128d dx = _mm_sub_pd(_mm_loadu_pd(posX + j), xi);
+            __m128d dy = _mm_sub_pd(_mm_loadu_pd(posY + j), yi);
+            __m128d dz = _mm_sub_pd(_mm_loadu_pd(posZ + j), zi);
+            __m128d distanceSq = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_add_pd(_mm_mul_pd(dy, dy), _mm_mul_pd(dz, dz)));
+
+            __m128d valid = _mm_cmpgt_pd(distanceSq, zero);
+            __m128d invDistanceCubed = _mm_and_pd(valid,
+                _mm_div_pd(one, _mm_mul_pd(distanceSq, _mm_sqrt_pd(distanceSq))));
+
+            __m128d strength = _mm_mul_pd(_mm_loadu_pd(masses + j), invDistanceCubed);
+            vSumX = _mm_add_pd(vSumX, _mm_mul_pd(dx, strength));
+            vSumY = _mm_add_pd(vSumY, _mm_mul_pd(dy, strength));
+            vSumZ = _mm_add_pd(vSumZ, _mm_mul_pd(dz, strength));
+        }
+
+        sumX = Sum(vSumX);
+        sumY = Sum(vSumY);
+        sumZ = Sum(vSumZ);
+#endif
+
+          // Leftover bodies (or every body without SIMD)
+        for (; j < count; ++j) {
+            Pull(posX, posY, posZ, masses, i, j, sumX, sumY, sumZ);
+        }
+
+        accelX[i] = sumX;
+        accelY[i] = sumY;
+        accelZ[i] = sumZ;
+    }
+}
+
+/**
+ * @brief Returns the name of the instruction set the kernel was built with
+ *
+ * @return const char*
+ */
+const char* Direct_Gravity::GetInstructionSet() {
+#if defined(__AVX__)
+    return "AVX";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
@@ -0,0 +1,32 @@
+/**
+ * @file direct_gravity.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-04
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef DIRECT_GRAVITY_HPP
+#define DIRECT_GRAVITY_HPP
+
+/*! Direct_Gravity class */
+class Direct_Gravity {
+    public:
+        static void Compute(const float* posX, const float* posY, const float* posZ, const float* masses,
+            float* accelX, float* accelY, float* accelZ, unsigned begin, unsigned end, unsigned count);
+        static void Compute(const double* posX, const double* posY, const double* posZ, const double* masses,
+            double* accelX, double* accelY, double* accelZ, unsigned begin, unsigned end, unsigned count);
+        static void ComputeFor(const float* posX, const float* posY, const float* posZ, const float* masses,
+            float* accelX, float* accelY, float* accelZ, const unsigned* targets, unsigned begin, unsigned end,
+            unsigned count);
+        static void ComputeFor(const double* posX, const double* posY, const double* posZ, const double* masses,
+            double* accelX, double* accelY, double* accelZ, const unsigned* targets, unsigned begin, unsigned end,
+            unsigned count);
+        static const char* GetInstructionSet();
+};
+
+#endif
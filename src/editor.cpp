@@ -19,13 +19,32 @@
 
 // Engine includes //
 #include "camera.hpp"
+#include "collision.hpp"
+#include "command_buffer.hpp"
 #include "editor.hpp"
 #include "engine.hpp"
+#include "force_field.hpp"
 #include "graphics.hpp"
+#include "gravity.hpp"
+#include "integrator.hpp"
+#include "neighbor_list.hpp"
 #include "object_manager.hpp"
 
 static Editor* editor = nullptr; //!< Editor object
 
+/**
+ * @brief Input box for a float value of the simulation state
+ * 
+ */
+static inline bool InputReal(const char* label, float* value) { return ImGui::InputFloat(label, value); }
+
+/**
+ * @brief Input box for a double value of the simulation state (double
+ *        precision builds)
+ * 
+ */
+static inline bool InputReal(const char* label, double* value) { return ImGui::InputDouble(label, value); }
+
 /**
  * @brief Sets up the config and style of the editor
  * 
@@ -201,27 +220,27 @@ void Editor::Display_Scene() {
               // Paste current selected object
             if (glfwGetKey(Graphics::GetWindow(), GLFW_KEY_V) == GLFW_PRESS) {
                 if (glfwGetKey(Graphics::GetWindow(), GLFW_KEY_V) == GLFW_RELEASE) {
-                    if (editor->object_to_copy != -1) {
-                        Object* object = new Object(*Object_Manager::FindObject(editor->selected_object));
-                        Object_Manager::AddObject(object);
-                    }
+                    Object* toCopy = Object_Manager::FindObject(editor->object_to_copy);
+                    if (toCopy) Command_Buffer::CreateObject(new Object(*toCopy));
                 }
             }
         }
     }
 
       // Display all objects
-    for (int i = 0; i < (int)Object_Manager::GetSize(); ++i) {
-        if (ImGui::Selectable(Object_Manager::FindObject(i)->GetName().c_str(), selected_object == i, ImGuiSelectableFlags_AllowDoubleClick)) {
-            if (selected_object != i) editor->selected_component = -1;
-            selected_object = i;
+    for (unsigned i = 0; i < Object_Manager::GetSize(); ++i) {
+        Object* object = Object_Manager::GetObjectAt(i);
+        int id = object->GetId();
+        if (ImGui::Selectable(object->GetName().c_str(), selected_object == id, ImGuiSelectableFlags_AllowDoubleClick)) {
+            if (selected_object != id) editor->selected_component = -1;
+            selected_object = id;
             selected_component = -1;
         }
 
           // Checking for right click behavior
         if (ImGui::IsItemClicked(ImGuiMouseButton_Right)) {
-            if (selected_object != i) editor->selected_component = -1;
-            selected_object = i;
+            if (selected_object != id) editor->selected_component = -1;
+            selected_object = id;
             selected_component = -1;
             ImGui::OpenPopup("ObjectSettings##1");
         }
@@ -230,7 +249,7 @@ void Editor::Display_Scene() {
     if (ImGui::BeginPopup("ObjectSettings##1")) {
           // Removes selected object from scene
         if (ImGui::Selectable("Delete##1")) {
-            Object_Manager::RemoveObject(selected_object);
+            Command_Buffer::DestroyObject(selected_object);
             selected_object = -1;
             selected_component = -1;
         }
@@ -240,10 +259,8 @@ void Editor::Display_Scene() {
         }
           // Pastes copied object into scene
         if (ImGui::Selectable("Paste##1")) {
-            if (editor->object_to_copy != -1) {
-                Object* object = new Object(*Object_Manager::FindObject(editor->selected_object));
-                Object_Manager::AddObject(object);
-            }
+            Object* toCopy = Object_Manager::FindObject(editor->object_to_copy);
+            if (toCopy) Command_Buffer::CreateObject(new Object(*toCopy));
         }
         ImGui::EndPopup();
     }
@@ -258,7 +275,7 @@ void Editor::Display_Scene() {
         newObject->SetName("New_Object");
         newObject->AddComponent(transform);
 
-        Object_Manager::AddObject(newObject);
+        Command_Buffer::CreateObject(newObject);
     }
     
     ImGui::End();
@@ -271,8 +288,8 @@ void Editor::Display_Scene() {
 void Editor::Display_Components() {
     ImGui::Begin("Components##1");
 
-    if (selected_object == -1) { ImGui::End(); return; }
     Object* object = Object_Manager::FindObject(selected_object);
+    if (!object) { selected_object = -1; ImGui::End(); return; }
     std::string objectName = object->GetName();
 
     ImGui::Text("Id: %d", object->GetId());
@@ -297,12 +314,12 @@ void Editor::Display_Components() {
     else templateName = Editor::Make_Display_String(templateName);
 
     if (ImGui::Button(templateName.c_str())) {
-        ImGuiFileDialog::Instance()->OpenDialog("ChooseTemplate##1", "Choose File", ".json", std::string(getenv("USERPROFILE")) + "/Documents/pEngine/json/objects/");
+        ImGuiFileDialog::Instance()->OpenDialog("ChooseTemplate##1", "Choose File", ".json", Engine::GetDataPath() + "json/objects/");
     }
 
     ImGui::SameLine();
     if (ImGui::Button("New Template")) {
-        ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##6", "Choose File", ".json", std::string(getenv("USERPROFILE")) + "/Documents/pEngine/json/objects/");
+        ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##6", "Choose File", ".json", Engine::GetDataPath() + "json/objects/");
     }
 
     
@@ -348,20 +365,17 @@ void Editor::Display_Components() {
     if (ImGui::BeginPopup("New Component##1")) {
         if (!physics) {
             if (ImGui::Selectable("Physics##1")) {
-                physics = new Physics;
-                object->AddComponent(physics);
+                Command_Buffer::AddComponent(object->GetId(), new Physics);
             }
         }
         if (!model) {
             if (ImGui::Selectable("Model##1")) {
-                model = new Model;
-                object->AddComponent(model);
+                Command_Buffer::AddComponent(object->GetId(), new Model);
             }
         }
         if (!behavior) {
             if (ImGui::Selectable("Scripts##1")) {
-                behavior = new Behavior;
-                object->AddComponent(behavior);
+                Command_Buffer::AddComponent(object->GetId(), new Behavior);
             }
         }
         ImGui::EndPopup();
@@ -383,7 +397,7 @@ void Editor::Display_World_Settings() {
       // Allows user to change the preset that is loaded
     ImGui::Text("Presets"); ImGui::SameLine(120);
     if (ImGui::Button(presetName.c_str())) {
-        ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##5", "Choose File", ".json", std::string(getenv("USERPROFILE")) + "/Documents/pEngine/json/preset/");
+        ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##5", "Choose File", ".json", Engine::GetDataPath() + "json/preset/");
     }
 
     if (ImGuiFileDialog::Instance()->Display("ChooseFileDlgKey##5")) {
@@ -419,6 +433,95 @@ void Editor::Display_World_Settings() {
     ImGui::Text("Grav Const");
     ImGui::SameLine(120); ImGui::InputDouble("##5", &Engine::GetGravConst());
 
+      // Barnes-Hut opening angle (0 is exact)
+    ImGui::Text("Opening Angle");
+    ImGui::SameLine(120); ImGui::SliderFloat("##6", &Gravity::GetOpeningAngle(), 0.f, 1.5f);
+
+      // Particle-mesh grid (0 uses the tree or exact forces)
+    ImGui::Text("Mesh Size");
+    int meshSize = int(Gravity::GetMeshSize());
+    ImGui::SameLine(120);
+    if (ImGui::InputInt("##17", &meshSize, 0, 0, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        if (meshSize < 0) meshSize = 0;
+        Gravity::SetMeshSize(unsigned(meshSize));
+    }
+
+      // Method used to move the objects each step
+    ImGui::Text("Integrator");
+    int method = Integrator::GetMethod();
+    ImGui::SameLine(120);
+    if (ImGui::Combo("##7", &method, Integrator::methodNames, Integrator::MethodCount))
+        Integrator::SetMethod(Integrator::Method(method));
+    if (Integrator::GetMethod() == Integrator::Block || Integrator::GetMethod() == Integrator::Verlet) {
+        ImGui::SameLine(); ImGui::Text("Pulls: %u", Integrator::GetPullCount());
+    }
+
+      // Leaving resting objects out of the physics updates
+    ImGui::Text("Sleeping");
+    ImGui::SameLine(120); ImGui::Checkbox("##14", &Integrator::GetAllowSleeping());
+    ImGui::SameLine(); ImGui::Text("Asleep: %u", Integrator::GetSleepingCount());
+
+      // Collisions between the objects
+    ImGui::Text("Collisions");
+    int broadphase = Collision::GetBroadphase();
+    ImGui::SameLine(120);
+    if (ImGui::Combo("##11", &broadphase, Collision::broadphaseNames, Collision::BroadphaseCount))
+        Collision::SetBroadphase(Collision::Broadphase(broadphase));
+
+    ImGui::Text("Restitution");
+    ImGui::SameLine(120); ImGui::SliderFloat("##12", &Collision::GetRestitution(), 0.f, 1.f);
+
+    ImGui::Text("Merge");
+    ImGui::SameLine(120); ImGui::Checkbox("##13", &Collision::GetMerge());
+    ImGui::SameLine(); ImGui::Text("Contacts: %u", Collision::GetContactCount());
+
+      // Lists of nearby bodies kept across steps
+    ImGui::Text("Neighbors");
+    ImGui::SameLine(120);
+    if (Neighbor_List::IsEnabled()) {
+        ImGui::Text("Cutoff: %.3g  Skin: %.3g  Builds: %u", double(Neighbor_List::GetCutoff()),
+            double(Neighbor_List::GetSkin()), Neighbor_List::GetBuildCount());
+    }
+    else ImGui::Text("off");
+
+      // Forces the preset puts on every body
+    ImGui::Text("Force Fields");
+    ImGui::SameLine(120);
+    if (Force_Field::GetFieldCount() == 0) ImGui::Text("none");
+    for (unsigned i = 0; i < Force_Field::GetFieldCount(); ++i) {
+        if (i > 0) ImGui::SameLine();
+        ImGui::Text("%s", Force_Field::typeNames[Force_Field::GetFieldType(i)]);
+    }
+
+      // Fixed time step of the physics updates
+    ImGui::Text("Fixed dt");
+    float dt = Engine::GetDt();
+    ImGui::SameLine(120);
+    if (ImGui::InputFloat("##8", &dt, 0.f, 0.f, "%.4f")) Engine::SetDt(dt);
+
+      // Bounds on the physics updates run in a single frame
+    ImGui::Text("Max Sub-Steps");
+    ImGui::SameLine(120); ImGui::InputInt("##9", &Engine::GetMaxSubSteps());
+    if (Engine::GetMaxSubSteps() < 1) Engine::GetMaxSubSteps() = 1;
+
+    ImGui::Text("Step Budget");
+    ImGui::SameLine(120); ImGui::InputFloat("##10", &Engine::GetStepBudget(), 0.f, 0.f, "%.3f s");
+
+      // Speeding up (or pausing) simulated time
+    ImGui::Text("Time Scale");
+    float timeScale = Engine::GetTimeScale();
+    ImGui::SameLine(120);
+    if (ImGui::SliderFloat("##15", &timeScale, 0.f, 10000.f, "%.2fx", ImGuiSliderFlags_Logarithmic))
+        Engine::SetTimeScale(timeScale);
+
+    ImGui::Text("Fast Forward");
+    ImGui::SameLine(120); ImGui::Checkbox("##16", &Engine::GetFastForward());
+
+      // How well the physics is keeping up
+    ImGui::Text("Sub-Steps: %u  Slow Frames: %u  Dropped: %.2f s", Engine::GetSubSteps(),
+        Engine::GetSlowFrames(), Engine::GetDroppedTime());
+    ImGui::Text("Simulated: %.1f s", Engine::GetTime());
+
     ImGui::PopItemWidth();
 
     ImGui::End();
@@ -460,20 +563,20 @@ void Editor::Display_Scripts(Behavior* behavior) {
     
     // Setting up tree flags
     ImGuiTreeNodeFlags node_flags = ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_OpenOnArrow;
-    if (selected_component == CType::CBehavior) node_flags |= ImGuiTreeNodeFlags_Selected;
+    if (selected_component == int(Behavior::GetCType())) node_flags |= ImGuiTreeNodeFlags_Selected;
     
-    const bool scripts_open = ImGui::TreeNodeEx((void*)(intptr_t)CType::CBehavior, node_flags, "Scripts");
-    if (ImGui::IsItemClicked()) selected_component = CType::CBehavior;
+    const bool scripts_open = ImGui::TreeNodeEx((void*)(intptr_t)Behavior::GetCType(), node_flags, "Scripts");
+    if (ImGui::IsItemClicked()) selected_component = Behavior::GetCType();
 
       // Right click behavior to delete script component from object
     if (ImGui::IsItemClicked(ImGuiMouseButton_Right)) {
-        selected_component = CType::CBehavior;
+        selected_component = Behavior::GetCType();
         ImGui::OpenPopup("DeleteScripts##1");
     }
 
     if (ImGui::BeginPopup("DeleteScripts##1")) {
         if (ImGui::Selectable("Delete##2")) {
-            behavior->GetParent()->RemoveComponent<Behavior>();
+            Command_Buffer::RemoveComponent(behavior->GetParent()->GetId(), Behavior::GetCType());
             selected_component = -1;
         }
         ImGui::EndPopup();
@@ -481,13 +584,14 @@ void Editor::Display_Scripts(Behavior* behavior) {
 
       // Displays the currently attached scripts
     if (scripts_open) {
-        std::vector<std::string>& scripts = behavior->GetScripts();
+          // Copy of the list, SwitchScript can replace it while it's being shown
+        std::vector<std::string> scripts = behavior->GetScripts();
         unsigned scriptNum = 1;
         for (std::string& script : scripts) {
             ImGui::Text(std::string("Script " + std::to_string(scriptNum) + ":").c_str());
             ImGui::SameLine(100);
             if (ImGui::Button(Editor::Make_Display_String(script).c_str())) {
-                ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##3", "Choose File", ".lua", std::string(getenv("USERPROFILE")) + "/Documents/pEngine/scripts/");
+                ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##3", "Choose File", ".lua", Engine::GetDataPath() + "scripts/");
             }
 
             if (ImGuiFileDialog::Instance()->Display("ChooseFileDlgKey##3")) {
@@ -505,7 +609,7 @@ void Editor::Display_Scripts(Behavior* behavior) {
           // Add new script to the object
         ImGui::Indent(71);
         if (ImGui::Button("New Script##1")) {
-            ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##4", "Choose File", ".lua", std::string(getenv("USERPROFILE")) + "/Documents/pEngine/scripts/");
+            ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##4", "Choose File", ".lua", Engine::GetDataPath() + "scripts/");
         }
 
         if (ImGuiFileDialog::Instance()->Display("ChooseFileDlgKey##4")) {
@@ -545,20 +649,20 @@ void Editor::Display_Model(Model* model) {
     
       // Setting up tree flags
     ImGuiTreeNodeFlags node_flags = ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_OpenOnArrow;
-    if (selected_component == CType::CModel) node_flags |= ImGuiTreeNodeFlags_Selected;
+    if (selected_component == int(Model::GetCType())) node_flags |= ImGuiTreeNodeFlags_Selected;
     
-    const bool model_open = ImGui::TreeNodeEx((void*)(intptr_t)CType::CModel, node_flags, "Model");
-    if (ImGui::IsItemClicked()) selected_component = CType::CModel;
+    const bool model_open = ImGui::TreeNodeEx((void*)(intptr_t)Model::GetCType(), node_flags, "Model");
+    if (ImGui::IsItemClicked()) selected_component = Model::GetCType();
 
       // Right click behavior to delete model component from selected object
     if (ImGui::IsItemClicked(ImGuiMouseButton_Right)) {
-        selected_component = CType::CModel;
+        selected_component = Model::GetCType();
         ImGui::OpenPopup("DeleteModel##1");
     }
 
     if (ImGui::BeginPopup("DeleteModel##1")) {
         if (ImGui::Selectable("Delete##3")) {
-            model->GetParent()->RemoveComponent<Model>();
+            Command_Buffer::RemoveComponent(model->GetParent()->GetId(), Model::GetCType());
             selected_component = -1;
         }
         ImGui::EndPopup();
@@ -568,7 +672,7 @@ void Editor::Display_Model(Model* model) {
           // Model that is being used
         ImGui::Text("Model"); ImGui::SameLine(100);
         if (ImGui::Button(modelName.c_str())) {
-            ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##1", "Choose File", ".obj", std::string(getenv("USERPROFILE")) + "/Documents/pEngine/models/");
+            ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##1", "Choose File", ".obj", Engine::GetDataPath() + "models/");
         }
 
         if (ImGuiFileDialog::Instance()->Display("ChooseFileDlgKey##1")) {
@@ -584,7 +688,7 @@ void Editor::Display_Model(Model* model) {
           // Texture that is being used
         ImGui::Text("Texture"); ImGui::SameLine(100);
         if (ImGui::Button(textureName.c_str())) {
-            ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##2", "Choose File", ".dds,.DDS", std::string(getenv("USERPROFILE")) + "/Documents/pEngine/textures/");
+            ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##2", "Choose File", ".dds,.DDS", Engine::GetDataPath() + "textures/");
         }
 
         if (ImGuiFileDialog::Instance()->Display("ChooseFileDlgKey##2")) {
@@ -609,23 +713,23 @@ void Editor::Display_Model(Model* model) {
 void Editor::Display_Physics(Physics* physics) {
     if (!physics) return;
     
-    glm::vec3& velocity = physics->GetVelocityRef();
+    Vec3& velocity = physics->GetVelocityRef();
     glm::vec3& rotVel = physics->GetRotationalVelocityRef();
 
     ImGuiTreeNodeFlags node_flags = ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_OpenOnArrow;
-    if (selected_component == CType::CPhysics) node_flags |= ImGuiTreeNodeFlags_Selected;
+    if (selected_component == int(Physics::GetCType())) node_flags |= ImGuiTreeNodeFlags_Selected;
     
-    const bool physics_open = ImGui::TreeNodeEx((void*)(intptr_t)CType::CPhysics, node_flags, "Physics");
-    if (ImGui::IsItemClicked()) selected_component = CType::CPhysics;
+    const bool physics_open = ImGui::TreeNodeEx((void*)(intptr_t)Physics::GetCType(), node_flags, "Physics");
+    if (ImGui::IsItemClicked()) selected_component = Physics::GetCType();
 
     if (ImGui::IsItemClicked(ImGuiMouseButton_Right)) {
-        selected_component = CType::CPhysics;
+        selected_component = Physics::GetCType();
         ImGui::OpenPopup("DeletePhysics##1");
     }
 
     if (ImGui::BeginPopup("DeletePhysics##1")) {
         if (ImGui::Selectable("Delete##4")) {
-            physics->GetParent()->RemoveComponent<Physics>();
+            Command_Buffer::RemoveComponent(physics->GetParent()->GetId(), Physics::GetCType());
             selected_component = -1;
         }
         ImGui::EndPopup();
@@ -635,9 +739,9 @@ void Editor::Display_Physics(Physics* physics) {
         ImGui::Text("Velocity");
 
         ImGui::PushItemWidth(65);
-        ImGui::SameLine(100); ImGui::InputFloat("x##1", &velocity.x);
-        ImGui::SameLine(185); ImGui::InputFloat("y##1", &velocity.y);
-        ImGui::SameLine(270); ImGui::InputFloat("z##1", &velocity.z);
+        ImGui::SameLine(100); InputReal("x##1", &velocity.x);
+        ImGui::SameLine(185); InputReal("y##1", &velocity.y);
+        ImGui::SameLine(270); InputReal("z##1", &velocity.z);
 
         ImGui::Text("RotVel");
 
@@ -647,7 +751,7 @@ void Editor::Display_Physics(Physics* physics) {
         ImGui::SameLine(270); ImGui::InputFloat("z##6", &rotVel.z);
 
         ImGui::Text("Mass");
-        ImGui::SameLine(100); ImGui::InputFloat("##6", &physics->GetMassRef());
+        ImGui::SameLine(100); InputReal("##6", &physics->GetMassRef());
         ImGui::PopItemWidth();
 
         ImGui::TreePop();
@@ -662,24 +766,24 @@ void Editor::Display_Physics(Physics* physics) {
 void Editor::Display_Transform(Transform* transform) {
     if (!transform) return;
     
-    glm::vec3& position = transform->GetPositionRef();
+    Vec3& position = transform->GetPositionRef();
     glm::vec3& scale = transform->GetScaleRef();
     glm::vec3& rotation = transform->GetRotationRef();
-    glm::vec3& startPos = transform->GetStartPositionRef();
+    Vec3& startPos = transform->GetStartPositionRef();
 
     ImGuiTreeNodeFlags node_flags = ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_OpenOnArrow;
-    if (selected_component == CType::CTransform) node_flags |= ImGuiTreeNodeFlags_Selected;
+    if (selected_component == int(Transform::GetCType())) node_flags |= ImGuiTreeNodeFlags_Selected;
     
-    const bool transform_open = ImGui::TreeNodeEx((void*)(intptr_t)CType::CTransform, node_flags, "Transform");
-    if (ImGui::IsItemClicked()) selected_component = CType::CTransform;
+    const bool transform_open = ImGui::TreeNodeEx((void*)(intptr_t)Transform::GetCType(), node_flags, "Transform");
+    if (ImGui::IsItemClicked()) selected_component = Transform::GetCType();
 
     if (transform_open) {
         ImGui::Text("Position");
 
         ImGui::PushItemWidth(65);
-        ImGui::SameLine(100); ImGui::InputFloat("x##1", &position.x);
-        ImGui::SameLine(185); ImGui::InputFloat("y##1", &position.y);
-        ImGui::SameLine(270); ImGui::InputFloat("z##1", &position.z);
+        ImGui::SameLine(100); InputReal("x##1", &position.x);
+        ImGui::SameLine(185); InputReal("y##1", &position.y);
+        ImGui::SameLine(270); InputReal("z##1", &position.z);
         ImGui::PopItemWidth();
 
         ImGui::Text("Scale");
@@ -701,9 +805,9 @@ void Editor::Display_Transform(Transform* transform) {
         ImGui::Text("Start Pos");
 
         ImGui::PushItemWidth(65);
-        ImGui::SameLine(100); ImGui::InputFloat("x##5", &startPos.x);
-        ImGui::SameLine(185); ImGui::InputFloat("y##5", &startPos.y);
-        ImGui::SameLine(270); ImGui::InputFloat("z##5", &startPos.z);
+        ImGui::SameLine(100); InputReal("x##5", &startPos.x);
+        ImGui::SameLine(185); InputReal("y##5", &startPos.y);
+        ImGui::SameLine(270); InputReal("z##5", &startPos.z);
         ImGui::PopItemWidth();
 
         ImGui::TreePop();
@@ -721,7 +825,7 @@ void Editor::Display_Menu_Bar() {
                 Engine::Write();
             }
             if (ImGui::MenuItem("Save As..##1")) {
-                ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##7", "Choose File", ".json", std::string(getenv("USERPROFILE")) + "/Documents/pEngine/json/preset");
+                ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey##7", "Choose File", ".json", Engine::GetDataPath() + "json/preset");
             }
 
             ImGui::EndMenu();
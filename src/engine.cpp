@@ -10,20 +10,33 @@
  */
 
 // std includes //
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <string>
 
 // Engine includes
   // System //
+#include "collision.hpp"
 #include "engine.hpp"
+#include "force_field.hpp"
 #include "graphics.hpp"
+#include "gravity.hpp"
+#include "integrator.hpp"
+#include "job_system.hpp"
+#include "neighbor_list.hpp"
   // Object //
 #include "object_manager.hpp"
 #include "object.hpp"
   // Component //
+#include "command_buffer.hpp"
 #include "component.hpp"
+#include "component_storage.hpp"
+#include "direct_gravity.hpp"
 #include "model_data_manager.hpp"
 #include "physics.hpp"
+#include "prototype_manager.hpp"
   // Misc //
 #include "camera.hpp"
 #include "editor.hpp"
@@ -32,6 +45,12 @@
 #include "texture_manager.hpp"
 
 static Engine* engine = nullptr; //!< Engine object
+static std::string dataPath;     //!< Folder the engine's files are read from (set before the engine exists)
+
+static const float defaultDt = 0.01f;         //!< Fixed delta time used when the preset doesn't set one
+static const int defaultMaxSubSteps = 8;      //!< Physics updates per frame used when the preset doesn't set it
+static const float defaultStepBudget = 0.05f; //!< Seconds of physics per frame used when the preset doesn't set it
+static const float maxTimeScale = 10000.f;    //!< Fastest simulated time can be set to run (times real time)
 
 /**
  * @brief Initializes the engine and the systems in the engine
@@ -46,32 +65,59 @@ bool Engine::Initialize() {
         Trace::Message("Engine was not initialized.\n");
         return false;
     }
+
+    engine->isHeadless = false;
+    engine->dt = defaultDt;
+    engine->maxSubSteps = defaultMaxSubSteps;
+    engine->stepBudget = defaultStepBudget;
+    engine->timeScale = 1.f;
     
       // Initializing random
     if (!Random::Initialize()) return false;
 
+      // Starting worker threads
+    if (!Job_System::Initialize()) return false;
+
+      // Initializing storage for component data
+    if (!Component_Storage::Initialize()) return false;
+
+      // Initializing the buffer for object changes made during a step
+    if (!Command_Buffer::Initialize()) return false;
+
       // Reading settings from json
     File_Reader settings;
-    if (settings.Read_File(std::string(getenv("USERPROFILE")) + "/Documents/pEngine/json/settings.json")) {
+    if (settings.Read_File(Engine::GetDataPath() + "json/settings.json")) {
           // Setting up sub systems
         if (!Camera::Initialize(settings)) return false;
         if (!Graphics::Initialize(settings)) return false;
         if (!Model_Data_Manager::Initialize()) return false;
         if (!Texture_Manager::Initialize()) return false;
+        if (!Prototype_Manager::Initialize()) return false;
 
         File_Reader preset;
 
-        engine->presetName = std::string(getenv("USERPROFILE")) + "/Documents/pEngine/json/preset/" + settings.Read_String("preset");
+        engine->presetName = Engine::GetDataPath() + "json/preset/" + settings.Read_String("preset");
         if (preset.Read_File(engine->presetName)) {
             engine->gravConst = preset.Read_Double("gravConst");
+            ReadTiming(preset);
             engine->lightPos = preset.Read_Vec3("lightPos");
             if (engine->lightPos == glm::vec3(0.f)) {
                 engine->lightPos = glm::vec3(4, 4, 0);
             }
+            if (!Gravity::Initialize(preset)) return false;
+            if (!Integrator::Initialize(preset)) return false;
+            if (!Collision::Initialize(preset)) return false;
+            if (!Force_Field::Initialize(preset)) return false;
+            if (!Neighbor_List::Initialize(preset)) return false;
             if (!Object_Manager::Initialize(preset)) return false;
         }
         else {
             engine->presetName = "no preset";
+            if (!Gravity::Initialize()) return false;
+            if (!Integrator::Initialize()) return false;
+            if (!Collision::Initialize()) return false;
+            if (!Force_Field::Initialize()) return false;
+            if (!Neighbor_List::Initialize()) return false;
             if (!Object_Manager::Initialize()) return false;
         }
 
@@ -91,6 +137,12 @@ bool Engine::Initialize() {
         if (!Graphics::Initialize()) return false;
         if (!Model_Data_Manager::Initialize()) return false;
         if (!Texture_Manager::Initialize()) return false;
+        if (!Prototype_Manager::Initialize()) return false;
+        if (!Gravity::Initialize()) return false;
+        if (!Integrator::Initialize()) return false;
+        if (!Collision::Initialize()) return false;
+        if (!Force_Field::Initialize()) return false;
+        if (!Neighbor_List::Initialize()) return false;
         if (!Object_Manager::Initialize()) return false;
     }
 
@@ -100,7 +152,78 @@ bool Engine::Initialize() {
       // Setting up variables used for dt
     engine->currentTime = std::chrono::steady_clock::now();
     engine->accumulator = 0.f;
-    engine->time = 0.f;
+    engine->time = 0.0;
+    engine->subSteps = 0;
+    engine->droppedTime = 0.f;
+    engine->slowFrames = 0;
+    engine->isFastForward = false;
+    engine->isRunning = true;
+
+    return true;
+}
+
+/**
+ * @brief Initializes the engine without a window. Only the systems needed to
+ *        step the simulation are started (no graphics, camera, editor, models
+ *        or textures), so it can run where there is no display or OpenGL
+ * 
+ * @param presetName_ Preset to load (path, or name in the preset folder)
+ * @return true
+ * @return false
+ */
+bool Engine::InitializeHeadless(std::string presetName_) {
+      // Initializing engine
+    engine = new Engine;
+    if (!engine) {
+        Trace::Message("Engine was not initialized.\n");
+        return false;
+    }
+
+    engine->isHeadless = true;
+    engine->dt = defaultDt;
+    engine->maxSubSteps = defaultMaxSubSteps;
+    engine->stepBudget = defaultStepBudget;
+    engine->timeScale = 1.f;
+    engine->lightPower = 1000.f;
+    engine->lightPos = glm::vec3(4, 4, 0);
+
+      // Finding the preset (given path first, then the preset folder)
+    File_Reader preset;
+    engine->presetName = presetName_;
+    if (!preset.Read_File(engine->presetName)) {
+        engine->presetName = GetDataPath() + "json/preset/" + presetName_;
+        if (!preset.Read_File(engine->presetName)) {
+            Trace::Message("Preset " + presetName_ + " couldn't be read.\n");
+            return false;
+        }
+    }
+
+      // Setting up sub systems
+    if (!Random::Initialize()) return false;
+    if (!Job_System::Initialize()) return false;
+    if (!Component_Storage::Initialize()) return false;
+    if (!Command_Buffer::Initialize()) return false;
+    if (!Prototype_Manager::Initialize()) return false;
+
+    engine->gravConst = preset.Read_Double("gravConst");
+    ReadTiming(preset);
+    if (!Gravity::Initialize(preset)) return false;
+    if (!Integrator::Initialize(preset)) return false;
+    if (!Collision::Initialize(preset)) return false;
+    if (!Force_Field::Initialize(preset)) return false;
+    if (!Neighbor_List::Initialize(preset)) return false;
+    if (!Object_Manager::Initialize(preset)) return false;
+      // Objects made while loading are added before the first step
+    Command_Buffer::Apply();
+
+      // Setting up variables used for dt
+    engine->currentTime = std::chrono::steady_clock::now();
+    engine->accumulator = 0.f;
+    engine->time = 0.0;
+    engine->subSteps = 0;
+    engine->droppedTime = 0.f;
+    engine->slowFrames = 0;
+    engine->isFastForward = false;
     engine->isRunning = true;
 
     return true;
@@ -108,7 +231,12 @@ bool Engine::Initialize() {
 
 /**
  * @brief Updates object and camera. Object updates have a fixed time step,
- *        camera updates have variable time step
+ *        camera updates have variable time step. The number of object updates
+ *        in a frame is bounded by maxSubSteps and stepBudget, time that can't
+ *        be caught up on is dropped so one slow frame doesn't slow down the
+ *        frames after it. Simulated time runs timeScale times as fast as real
+ *        time, or as fast as stepBudget allows when fast forwarding (the
+ *        objects are only drawn once per frame however many updates ran)
  * 
  * @return void
  */
@@ -119,20 +247,115 @@ void Engine::Update() {
     engine->deltaTime = float(engine->timeTaken.count()) * 
         std::chrono::steady_clock::period::num / std::chrono::steady_clock::period::den;
     engine->currentTime = engine->newTime;
-    engine->accumulator += engine->deltaTime;
+    engine->accumulator += engine->deltaTime * engine->timeScale;
+
+      // Dropping time that more than maxSubSteps updates would be needed for
+      // (sped up time gets more updates, stepBudget still bounds the frame)
+    float maxAccumulator = engine->maxSubSteps * std::max(engine->timeScale, 1.f) * engine->dt;
+    if (engine->accumulator > maxAccumulator) {
+        engine->droppedTime += engine->accumulator - maxAccumulator;
+        engine->accumulator = maxAccumulator;
+    }
 
     Editor::Update();
     Camera::Update();
+      // Applying changes made by the editor since the last frame
+    Command_Buffer::Apply();
       // Only called when it is time (fixed time step)
-    while (engine->accumulator >= engine->dt) {
+    engine->subSteps = 0;
+    std::chrono::steady_clock::time_point stepStart = std::chrono::steady_clock::now();
+      // Fast forwarding isn't paced by real time, so nothing is left to blend.
+      // A time scale of 0 pauses it too
+    const bool isFastForward = engine->isFastForward && engine->timeScale > 0.f;
+    if (isFastForward) engine->accumulator = 0.f;
+    while (isFastForward || engine->accumulator >= engine->dt) {
           // Update objects
         Object_Manager::Update();
+          // Sync point, objects created or destroyed during the step are applied
+        Command_Buffer::Apply();
           // Update dt related variables
-        engine->accumulator -= engine->dt;
+        if (!isFastForward) engine->accumulator -= engine->dt;
         engine->time += engine->dt;
+        ++engine->subSteps;
+
+          // Out of time for this frame, what is left waits for the next one
+        std::chrono::duration<float> stepTime = std::chrono::steady_clock::now() - stepStart;
+        if (stepTime.count() >= engine->stepBudget) {
+            if (isFastForward) break;
+            if (engine->accumulator >= engine->dt) {
+                ++engine->slowFrames;
+                break;
+            }
+        }
     }
 }
 
+/**
+ * @brief Steps the simulation as fast as it can (no frames, every step is
+ *        dt long) until the given number of steps or seconds of real time is
+ *        reached, then reports how fast it ran
+ * 
+ * @param steps Steps to run (0 to only stop on time)
+ * @param seconds Real time to run for (0 to only stop on steps)
+ * @return void
+ */
+void Engine::RunHeadless(unsigned steps, float seconds) {
+    unsigned stepCount = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::duration<float> elapsed(0.f);
+
+    while (engine->isRunning) {
+        if (steps > 0 && stepCount >= steps) break;
+        if (seconds > 0.f && elapsed.count() >= seconds) break;
+
+          // Update objects
+        Object_Manager::Update();
+          // Sync point, objects created or destroyed during the step are applied
+        Command_Buffer::Apply();
+          // Update dt related variables
+        engine->time += engine->dt;
+        ++stepCount;
+
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+
+      // Reporting the run
+    float stepsPerSecond = elapsed.count() > 0.f ? stepCount / elapsed.count() : 0.f;
+    char report[512];
+    std::snprintf(report, sizeof(report),
+        "%s: %u steps (%.3f s simulated) in %.3f s, %.1f steps/s, %u objects, %u threads, %s gravity\n",
+        engine->presetName.c_str(), stepCount, engine->time, elapsed.count(), stepsPerSecond,
+        Object_Manager::GetSize(), Job_System::GetThreadCount(), Direct_Gravity::GetInstructionSet());
+    Trace::Message(report);
+}
+
+/**
+ * @brief Writes the current position, velocity and mass of every object to
+ *        the given file at full precision (used to check the end of a
+ *        headless run)
+ * 
+ * @param filename 
+ * @return true
+ * @return false
+ */
+bool Engine::WriteState(std::string filename) {
+    File_Writer writer;
+
+    writer.Write_String("preset", engine->presetName);
+    writer.Write_Value("time", engine->time);
+    writer.Write_Value("dt", engine->dt);
+    for (unsigned i = 0; i < Object_Manager::GetSize(); ++i) {
+        writer.Write_Object_State(Object_Manager::GetObjectAt(i), i);
+    }
+
+    if (!writer.Write_File(filename, true)) {
+        Trace::Message("State file " + filename + " couldn't be opened.\n");
+        return false;
+    }
+
+    return true;
+}
+
 /**
  * @brief Shutdown systems and then engine
  * 
@@ -144,11 +367,22 @@ void Engine::Shutdown() {
       // Shutdown sub systems
     Editor::Shutdown();
     Random::Shutdown();
+    Command_Buffer::Shutdown();
+      // Prototypes keep components, so they go with the objects (before the
+      // pools and the storage are freed)
+    Prototype_Manager::Shutdown();
     Object_Manager::Shutdown();
+    Component_Storage::Shutdown();
+    Gravity::Shutdown();
+    Integrator::Shutdown();
+    Collision::Shutdown();
+    Force_Field::Shutdown();
+    Neighbor_List::Shutdown();
     Graphics::Shutdown();
     Camera::Shutdown();
     Texture_Manager::Shutdown();
     Model_Data_Manager::Shutdown();
+    Job_System::Shutdown();
 
       // Delete engine object
     delete engine;
@@ -164,19 +398,39 @@ void Engine::Shutdown() {
 bool Engine::Restart() {
       // Initializing object manager
     File_Reader settings;
-    if (! settings.Read_File(std::string(getenv("USERPROFILE")) + "/Documents/pEngine/json/settings.json")) return false;
+    if (! settings.Read_File(Engine::GetDataPath() + "json/settings.json")) return false;
 
     File_Reader preset;
     if (!preset.Read_File(engine->presetName)) return false;
 
-      // Removing all current objects
+      // Removing all current objects (and the kept templates, which are read
+      // again in case they changed)
+    Command_Buffer::Clear();
+    Prototype_Manager::Shutdown();
     Object_Manager::Shutdown();
+    Gravity::Shutdown();
+    Integrator::Shutdown();
+    Collision::Shutdown();
+    Force_Field::Shutdown();
+    Neighbor_List::Shutdown();
     Editor::Reset();
 
+    if (!Prototype_Manager::Initialize()) return false;
+
     engine->presetName = settings.Read_String("preset");
     engine->gravConst = preset.Read_Double("gravConst");
+    ReadTiming(preset);
+    if (!Gravity::Initialize(preset)) return false;
+    if (!Integrator::Initialize(preset)) return false;
+    if (!Collision::Initialize(preset)) return false;
+    if (!Force_Field::Initialize(preset)) return false;
+    if (!Neighbor_List::Initialize(preset)) return false;
     if (!Object_Manager::Initialize(preset)) return false;
 
+      // Time spent restarting isn't simulated
+    engine->currentTime = std::chrono::steady_clock::now();
+    engine->accumulator = 0.f;
+
     return true;
 }
 
@@ -190,19 +444,39 @@ bool Engine::Restart() {
 bool Engine::Restart(std::string presetName) {
       // Initializing object manager
     File_Reader settings;
-    settings.Read_File(std::string(getenv("USERPROFILE")) + "/Documents/pEngine/json/settings.json");
+    settings.Read_File(Engine::GetDataPath() + "json/settings.json");
     Trace::Message(presetName + "\n");
     File_Reader preset;
     if (!preset.Read_File(presetName)) return false;
 
-      // Removing all current objects
+      // Removing all current objects (and the kept templates, which are read
+      // again in case they changed)
+    Command_Buffer::Clear();
+    Prototype_Manager::Shutdown();
     Object_Manager::Shutdown();
+    Gravity::Shutdown();
+    Integrator::Shutdown();
+    Collision::Shutdown();
+    Force_Field::Shutdown();
+    Neighbor_List::Shutdown();
     Editor::Reset();
 
+    if (!Prototype_Manager::Initialize()) return false;
+
     engine->presetName = presetName;
     engine->gravConst = preset.Read_Double("gravConst");
+    ReadTiming(preset);
+    if (!Gravity::Initialize(preset)) return false;
+    if (!Integrator::Initialize(preset)) return false;
+    if (!Collision::Initialize(preset)) return false;
+    if (!Force_Field::Initialize(preset)) return false;
+    if (!Neighbor_List::Initialize(preset)) return false;
     if (!Object_Manager::Initialize(preset)) return false;
 
+      // Time spent restarting isn't simulated
+    engine->currentTime = std::chrono::steady_clock::now();
+    engine->accumulator = 0.f;
+
     return true;
 }
 
@@ -220,6 +494,97 @@ float Engine::GetDeltaTime() { return engine->deltaTime; }
  */
 float Engine::GetDt() { return engine->dt; }
 
+/**
+ * @brief Returns how far the current frame is between the last physics update
+ *        and the next one (0 to 1, used to blend what is drawn)
+ * 
+ * @return float 
+ */
+float Engine::GetAlpha() {
+    float alpha = engine->accumulator / engine->dt;
+    return alpha < 1.f ? alpha : 1.f;
+}
+
+/**
+ * @brief Sets the fixed delta time (ignored if not above 0)
+ * 
+ * @param dt_ New fixed delta time
+ * @return void
+ */
+void Engine::SetDt(float dt_) {
+    if (dt_ > 0.f) engine->dt = dt_;
+}
+
+/**
+ * @brief Returns reference to the most physics updates run in one frame
+ * 
+ * @return int& 
+ */
+int& Engine::GetMaxSubSteps() { return engine->maxSubSteps; }
+
+/**
+ * @brief Returns reference to the most real time (seconds) spent on physics
+ *        updates in one frame
+ * 
+ * @return float& 
+ */
+float& Engine::GetStepBudget() { return engine->stepBudget; }
+
+/**
+ * @brief Returns the number of physics updates run last frame
+ * 
+ * @return unsigned 
+ */
+unsigned Engine::GetSubSteps() { return engine->subSteps; }
+
+/**
+ * @brief Returns the total simulation time thrown away because frames fell
+ *        too far behind
+ * 
+ * @return float 
+ */
+float Engine::GetDroppedTime() { return engine->droppedTime; }
+
+/**
+ * @brief Returns the number of frames that ran out of step budget
+ * 
+ * @return unsigned 
+ */
+unsigned Engine::GetSlowFrames() { return engine->slowFrames; }
+
+/**
+ * @brief Returns reference to how many simulated seconds pass per real second
+ * 
+ * @return float& 
+ */
+float& Engine::GetTimeScale() { return engine->timeScale; }
+
+/**
+ * @brief Sets how many simulated seconds pass per real second (0 pauses,
+ *        kept between 0 and maxTimeScale)
+ * 
+ * @param timeScale_ 
+ * @return void
+ */
+void Engine::SetTimeScale(float timeScale_) {
+    engine->timeScale = std::min(std::max(timeScale_, 0.f), maxTimeScale);
+}
+
+/**
+ * @brief Returns reference to whether each frame runs as many physics updates
+ *        as fit in the step budget
+ * 
+ * @return bool& 
+ */
+bool& Engine::GetFastForward() { return engine->isFastForward; }
+
+/**
+ * @brief Returns the simulated time since the preset was loaded
+ * 
+ * @return double 
+ */
+double Engine::GetTime() { return engine->time; }
+
 /**
  * @brief Returns gravitational constant
  * 
@@ -259,6 +624,15 @@ void Engine::Write() {
 
     writer.Write_Value("gravConst", engine->gravConst);
     writer.Write_Vec3("lightPos", engine->lightPos);
+    writer.Write_Value("dt", engine->dt);
+    writer.Write_Value("maxSubSteps", engine->maxSubSteps);
+    writer.Write_Value("stepBudget", engine->stepBudget);
+    writer.Write_Value("timeScale", engine->timeScale);
+    Gravity::Write(writer);
+    Integrator::Write(writer);
+    Collision::Write(writer);
+    Force_Field::Write(writer);
+    Neighbor_List::Write(writer);
     Object_Manager::Write(writer);
     
     writer.Write_File(engine->presetName);
@@ -273,3 +647,60 @@ void Engine::Write() {
 void Engine::SetPresetName(std::string presetName_) {
     engine->presetName = presetName_;
 }
+
+/**
+ * @brief Reads the fixed time step settings from the preset (defaults are used
+ *        for any that are missing)
+ * 
+ * @param preset Preset being loaded
+ * @return void
+ */
+void Engine::ReadTiming(File_Reader& preset) {
+    engine->dt = preset.Read_Float("dt");
+    if (engine->dt <= 0.f) engine->dt = defaultDt;
+
+    engine->maxSubSteps = preset.Read_Int("maxSubSteps");
+    if (engine->maxSubSteps <= 0) engine->maxSubSteps = defaultMaxSubSteps;
+
+    engine->stepBudget = preset.Read_Float("stepBudget");
+    if (engine->stepBudget <= 0.f) engine->stepBudget = defaultStepBudget;
+
+    float timeScale = preset.Read_Float("timeScale");
+    SetTimeScale(timeScale > 0.f ? timeScale : 1.f);
+}
+
+/**
+ * @brief Returns whether the engine is running without a window
+ * 
+ * @return true
+ * @return false
+ */
+bool Engine::IsHeadless() { return engine && engine->isHeadless; }
+
+/**
+ * @brief Returns the folder the engine's files are in (ends in a slash). Uses
+ *        Documents/pEngine in the user's folder (USERPROFILE, or HOME when
+ *        that isn't set) unless another folder was given
+ * 
+ * @return std::string 
+ */
+std::string Engine::GetDataPath() {
+    if (!dataPath.empty()) return dataPath;
+
+    const char* home = getenv("USERPROFILE");
+    if (!home) home = getenv("HOME");
+    if (!home) return "./";
+
+    return std::string(home) + "/Documents/pEngine/";
+}
+
+/**
+ * @brief Sets the folder the engine's files are read from
+ * 
+ * @param dataPath_ 
+ * @return void
+ */
+void Engine::SetDataPath(std::string dataPath_) {
+    dataPath = dataPath_;
+    if (!dataPath.empty() && dataPath.back() != '/' && dataPath.back() != '\\') dataPath += '/';
+}
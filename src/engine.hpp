@@ -20,28 +20,58 @@
 // Library includes //
 #include <vec3.hpp>
 
+// Engine includes //
+#include "file_reader.hpp"
+
 /*! Engine class */
 class Engine {
     public:
         static bool Initialize();
+        static bool InitializeHeadless(std::string presetName_);
         static void Update();
+        static void RunHeadless(unsigned steps, float seconds);
+        static bool WriteState(std::string filename);
         static void Shutdown();
         static bool Restart();
         static bool Restart(std::string presetName);
         static float GetDeltaTime();
         static float GetDt();
+        static float GetAlpha();
+        static void SetDt(float dt_);
+        static int& GetMaxSubSteps();
+        static float& GetStepBudget();
+        static unsigned GetSubSteps();
+        static float GetDroppedTime();
+        static unsigned GetSlowFrames();
+        static float& GetTimeScale();
+        static void SetTimeScale(float timeScale_);
+        static bool& GetFastForward();
+        static double GetTime();
         static double& GetGravConst();
         static std::string GetPresetName();
         static float& GetLightPower();
         static glm::vec3& GetLightPos();
         static void Write();
         static void SetPresetName(std::string presetName_);
+        static bool IsHeadless();
+        static std::string GetDataPath();
+        static void SetDataPath(std::string dataPath_);
+    private:
+        static void ReadTiming(File_Reader& preset);
     private:
         bool  isRunning;        //!< state of the main loop
+        bool  isHeadless;       //!< whether the engine runs without a window (no graphics, camera or editor)
         float deltaTime;        //!< time between frames
         float accumulator;      //!< amount of unused time for physics updates
-        float time;             //!< total time
-        const float dt = 0.01f; //!< fixed delta time for physics updates
+        double time;            //!< total time (double, a float stops growing by dt after a few days)
+        float dt;               //!< fixed delta time for physics updates
+        int   maxSubSteps;      //!< most physics updates run in one frame
+        float stepBudget;       //!< most real time (seconds) spent on physics updates in one frame
+        unsigned subSteps;      //!< physics updates run last frame
+        float droppedTime;      //!< simulation time thrown away because a frame fell too far behind
+        unsigned slowFrames;    //!< frames that ran out of step budget before catching up
+        float timeScale;        //!< simulated seconds per real second (0 pauses)
+        bool  isFastForward;    //!< whether each frame runs as many physics updates as fit in stepBudget
 
         std::chrono::steady_clock::time_point currentTime; //!< current read time
         std::chrono::steady_clock::time_point newTime;     //!< newest read time
@@ -0,0 +1,92 @@
+/**
+ * @file fft.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-19
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// std includes //
+#include <cmath>
+#include <utility>
+#include <vector>
+
+// Engine includes //
+#include "fft.hpp"
+#include "job_system.hpp"
+
+static const double pi = 3.14159265358979323846; //!< Pi
+
+/**
+ * @brief Transforms the data in place (iterative Cooley-Tukey). The inverse
+ *        isn't divided by count, callers scale the result themselves
+ *
+ * @param data Values to transform
+ * @param count Number of values (power of two)
+ * @param inverse Whether to do the inverse transform
+ * @return void
+ */
+void FFT::Transform(std::complex<Real>* data, unsigned count, bool inverse) {
+      // Putting the values in bit reversed order
+    for (unsigned i = 1, j = 0; i < count; ++i) {
+        unsigned bit = count >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+
+      // Joining transforms of length / 2 into transforms of length
+    for (unsigned length = 2; length <= count; length <<= 1) {
+        const double angle = (inverse ? 2.0 : -2.0) * pi / length;
+        const std::complex<Real> step(Real(std::cos(angle)), Real(std::sin(angle)));
+        for (unsigned start = 0; start < count; start += length) {
+            std::complex<Real> twiddle(1);
+            for (unsigned k = 0; k < length / 2; ++k) {
+                std::complex<Real> even = data[start + k];
+                std::complex<Real> odd = data[start + k + length / 2] * twiddle;
+                data[start + k] = even + odd;
+                data[start + k + length / 2] = even - odd;
+                twiddle *= step;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Transforms a cube of data in place, one axis after another (spread
+ *        over the job system). Values are stored x first, then y, then z
+ *
+ * @param data Values to transform (size * size * size)
+ * @param size Number of values along each axis (power of two)
+ * @param inverse Whether to do the inverse transform
+ * @return void
+ */
+void FFT::Transform3D(std::complex<Real>* data, unsigned size, bool inverse) {
+    const unsigned strides[3] = { 1, size, size * size };
+
+    for (unsigned axis = 0; axis < 3; ++axis) {
+        const unsigned stride = strides[axis];
+          // The other two axes pick the line
+        const unsigned strideA = strides[(axis + 1) % 3];
+        const unsigned strideB = strides[(axis + 2) % 3];
+
+        Job_System::ParallelFor(size * size, 16, [=](unsigned begin, unsigned end) {
+              // Lines along y and z are copied out so the transform reads memory in order
+            std::vector<std::complex<Real>> line(size);
+            for (unsigned l = begin; l < end; ++l) {
+                std::complex<Real>* first = data + (l % size) * strideA + (l / size) * strideB;
+                if (stride == 1) {
+                    Transform(first, size, inverse);
+                    continue;
+                }
+
+                for (unsigned k = 0; k < size; ++k) line[k] = first[k * stride];
+                Transform(line.data(), size, inverse);
+                for (unsigned k = 0; k < size; ++k) first[k * stride] = line[k];
+            }
+        });
+    }
+}
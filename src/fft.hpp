@@ -0,0 +1,29 @@
+/**
+ * @file fft.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-19
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef FFT_HPP
+#define FFT_HPP
+
+// std includes //
+#include <complex>
+
+// Engine includes //
+#include "precision.hpp"
+
+/*! FFT class (radix-2 fast Fourier transforms, sizes are powers of two) */
+class FFT {
+    public:
+        static void Transform(std::complex<Real>* data, unsigned count, bool inverse);
+        static void Transform3D(std::complex<Real>* data, unsigned size, bool inverse);
+};
+
+#endif
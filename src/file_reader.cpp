@@ -129,6 +129,33 @@ double File_Reader::Read_Double(std::string valueName) {
     return root[valueName.c_str()].GetDouble();
 }
 
+/**
+ * @brief Reads a number from the json stored in root in the precision of the
+ *        simulation state (0 if it isn't there)
+ * 
+ * @param valueName Name of the number in the json file
+ * @return Real Value that was read
+ */
+Real File_Reader::Read_Real(std::string valueName) {
+    if (!root.HasMember(valueName.c_str())) return Real(0);
+
+    return Real(root[valueName.c_str()].GetDouble());
+}
+
+/**
+ * @brief Reads a vector from an array in the json stored in root in the
+ *        precision of the simulation state (zero if it isn't there)
+ * 
+ * @param valueName Name of the array in the json file
+ * @return Vec3 Value that was read
+ */
+Vec3 File_Reader::Read_Real_Vec3(std::string valueName) {
+    if (!root.HasMember(valueName.c_str())) return Vec3(0);
+
+    Value& array = root[valueName.c_str()];
+    return Vec3(array[0].GetDouble(), array[1].GetDouble(), array[2].GetDouble());
+}
+
 /**
  * @brief Reads the name of an object from an object list (preset folder)
  * 
@@ -169,15 +196,15 @@ std::string File_Reader::Read_Object_Template_Name(std::string valueName) {
  * @brief Reads the position of an object from an object list (preset folder)
  * 
  * @param valueName Specifies which object
- * @return glm::vec3 Position of object
+ * @return Vec3 Position of object
  */
-glm::vec3 File_Reader::Read_Object_Position(std::string valueName) {
+Vec3 File_Reader::Read_Object_Position(std::string valueName) {
     if (!root[valueName.c_str()].HasMember("position")) {
-        return glm::vec3(0.f, 0.f, 0.f);
+        return Vec3(0);
     }
 
     Value& array = root[valueName.c_str()]["position"];
-    return glm::vec3(array[0].GetFloat(), array[1].GetFloat(), array[2].GetFloat());
+    return Vec3(array[0].GetDouble(), array[1].GetDouble(), array[2].GetDouble());
 }
 
 /**
@@ -196,6 +223,100 @@ glm::vec3 File_Reader::Read_Object_Scale(std::string valueName) {
     return glm::vec3(array[0].GetFloat(), array[1].GetFloat(), array[2].GetFloat());
 }
 
+/**
+ * @brief Reads an int inside of an object in the file (0 if it isn't there)
+ * 
+ * @param valueName Name of the object
+ * @param memberName Name of the int inside of the object
+ * @return int 
+ */
+int File_Reader::Read_Member_Int(std::string valueName, std::string memberName) {
+      // Checking if the value exists
+    if (!root.HasMember(valueName.c_str())) return 0;
+    if (!root[valueName.c_str()].HasMember(memberName.c_str())) return 0;
+
+    return root[valueName.c_str()][memberName.c_str()].GetInt();
+}
+
+/**
+ * @brief Reads a string inside of an object in the file ("" if it isn't there)
+ * 
+ * @param valueName Name of the object
+ * @param memberName Name of the string inside of the object
+ * @return std::string 
+ */
+std::string File_Reader::Read_Member_String(std::string valueName, std::string memberName) {
+      // Checking if the value exists
+    if (!root.HasMember(valueName.c_str())) return std::string("");
+    if (!root[valueName.c_str()].HasMember(memberName.c_str())) return std::string("");
+
+    return root[valueName.c_str()][memberName.c_str()].GetString();
+}
+
+/**
+ * @brief Reads a vec3 inside of an object in the file (zero if it isn't there)
+ * 
+ * @param valueName Name of the object
+ * @param memberName Name of the array inside of the object
+ * @return glm::vec3 
+ */
+glm::vec3 File_Reader::Read_Member_Vec3(std::string valueName, std::string memberName) {
+      // Checking if the value exists
+    if (!root.HasMember(valueName.c_str())) return glm::vec3(0.f, 0.f, 0.f);
+    if (!root[valueName.c_str()].HasMember(memberName.c_str())) return glm::vec3(0.f, 0.f, 0.f);
+
+    Value& array = root[valueName.c_str()][memberName.c_str()];
+    return glm::vec3(array[0].GetFloat(), array[1].GetFloat(), array[2].GetFloat());
+}
+
+/**
+ * @brief Reads a float inside of an object in the file (0 if it isn't there)
+ * 
+ * @param valueName Name of the object
+ * @param memberName Name of the float inside of the object
+ * @return float 
+ */
+float File_Reader::Read_Member_Float(std::string valueName, std::string memberName) {
+      // Checking if the value exists
+    if (!root.HasMember(valueName.c_str())) return 0.f;
+    if (!root[valueName.c_str()].HasMember(memberName.c_str())) return 0.f;
+
+    return root[valueName.c_str()][memberName.c_str()].GetFloat();
+}
+
+/**
+ * @brief Reads a number inside of an object in the file in the precision of
+ *        the simulation state (0 if it isn't there)
+ * 
+ * @param valueName Name of the object
+ * @param memberName Name of the number inside of the object
+ * @return Real 
+ */
+Real File_Reader::Read_Member_Real(std::string valueName, std::string memberName) {
+      // Checking if the value exists
+    if (!root.HasMember(valueName.c_str())) return Real(0);
+    if (!root[valueName.c_str()].HasMember(memberName.c_str())) return Real(0);
+
+    return Real(root[valueName.c_str()][memberName.c_str()].GetDouble());
+}
+
+/**
+ * @brief Reads a vector inside of an object in the file in the precision of
+ *        the simulation state (zero if it isn't there)
+ * 
+ * @param valueName Name of the object
+ * @param memberName Name of the array inside of the object
+ * @return Vec3 
+ */
+Vec3 File_Reader::Read_Member_Real_Vec3(std::string valueName, std::string memberName) {
+      // Checking if the value exists
+    if (!root.HasMember(valueName.c_str())) return Vec3(0);
+    if (!root[valueName.c_str()].HasMember(memberName.c_str())) return Vec3(0);
+
+    Value& array = root[valueName.c_str()][memberName.c_str()];
+    return Vec3(array[0].GetDouble(), array[1].GetDouble(), array[2].GetDouble());
+}
+
 /**
  * @brief Reads the name of the behavior
  * 
@@ -204,7 +325,7 @@ glm::vec3 File_Reader::Read_Object_Scale(std::string valueName) {
  */
 std::string File_Reader::Read_Behavior_Name(std::string valueName) {
       // Checking if value exists
-    if (!root["behaviors"].HasMember(valueName.c_str())) {
+    if (!root.HasMember("behaviors") || !root["behaviors"].HasMember(valueName.c_str())) {
         return std::string("");
     }
 
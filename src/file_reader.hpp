@@ -20,6 +20,9 @@
 #include <document.h>
 #include <vec3.hpp>
 
+// Engine includes //
+#include "precision.hpp"
+
 /*! File_Reader class */
 class File_Reader {
     public:
@@ -31,12 +34,21 @@ class File_Reader {
         bool Read_Bool(std::string valueName);
         float Read_Float(std::string valueName);
         double Read_Double(std::string valueName);
+        Real Read_Real(std::string valueName);
+        Vec3 Read_Real_Vec3(std::string valueName);
 
         std::string Read_Object_Name(std::string valueName);
         std::string Read_Object_Template_Name(std::string valueName);
-        glm::vec3 Read_Object_Position(std::string valueName);
+        Vec3 Read_Object_Position(std::string valueName);
         glm::vec3 Read_Object_Scale(std::string valueName);
 
+        int Read_Member_Int(std::string valueName, std::string memberName);
+        std::string Read_Member_String(std::string valueName, std::string memberName);
+        glm::vec3 Read_Member_Vec3(std::string valueName, std::string memberName);
+        float Read_Member_Float(std::string valueName, std::string memberName);
+        Real Read_Member_Real(std::string valueName, std::string memberName);
+        Vec3 Read_Member_Real_Vec3(std::string valueName, std::string memberName);
+
         std::string Read_Behavior_Name(std::string valueName);
 
     private:
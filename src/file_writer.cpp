@@ -15,6 +15,7 @@
 
 // Engine includes //
 #include "file_writer.hpp"
+#include "physics.hpp"
 #include "trace.hpp"
 #include "transform.hpp"
 
@@ -32,20 +33,30 @@ File_Writer::File_Writer() {
  * @brief Writes all the data stored in root to the given filename
  * 
  * @param filename 
+ * @param isFullPrecision Whether float builds keep every digit (otherwise
+ *        values are rounded to 3 decimal places to keep templates readable)
+ * @return true
+ * @return false The file couldn't be opened
  */
-void File_Writer::Write_File(std::string filename) {
+bool File_Writer::Write_File(std::string filename, bool isFullPrecision) {
     std::string fileToOpen = filename;
     FILE* file = fopen(fileToOpen.c_str(), "w");
+    if (!file) return false;
 
     char buffer[65536];
     FileWriteStream stream(file, buffer, sizeof(buffer));
 
     PrettyWriter<FileWriteStream> writer(stream);
-    writer.SetMaxDecimalPlaces(3);
+#ifdef PENGINE_DOUBLE_PRECISION
+      // Double precision state is always written in full
+    isFullPrecision = true;
+#endif
+    if (!isFullPrecision) writer.SetMaxDecimalPlaces(3);
     writer.SetFormatOptions(kFormatSingleLineArray);
     root.Accept(writer);
 
     fclose(file);
+    return true;
 }
 
 /**
@@ -66,6 +77,24 @@ void File_Writer::Write_Vec3(std::string valueName, glm::vec3 value) {
     root.AddMember(name, vector3, root.GetAllocator());
 }
 
+#ifdef PENGINE_DOUBLE_PRECISION
+/**
+ * @brief Write a Vec3 into root without rounding it to float
+ * 
+ * @param valueName Name of Vec3
+ * @param value Vec3 to write
+ */
+void File_Writer::Write_Vec3(std::string valueName, const Vec3& value) {
+    Value vector3(kArrayType);
+    vector3.PushBack(value.x, root.GetAllocator());
+    vector3.PushBack(value.y, root.GetAllocator());
+    vector3.PushBack(value.z, root.GetAllocator());
+
+    Value name(valueName.c_str(), SizeType(valueName.size()), root.GetAllocator());
+    root.AddMember(name, vector3, root.GetAllocator());
+}
+#endif
+
 /**
  * @brief Write a std::string into root
  * 
@@ -80,12 +109,66 @@ void File_Writer::Write_String(std::string valueName, std::string value) {
     root.AddMember(name, newValue, root.GetAllocator());
 }
 
+/**
+ * @brief Write a glm::vec3 inside of an object in root (the object is made
+ *        if it isn't there yet)
+ * 
+ * @param valueName Name of the object
+ * @param memberName Name of the glm::vec3
+ * @param value glm::vec3 to write
+ */
+void File_Writer::Write_Member_Vec3(std::string valueName, std::string memberName, glm::vec3 value) {
+      // Storing glm::vec3 in array that rapidjson can write
+    Value vector3(kArrayType);
+    vector3.PushBack(value.x, root.GetAllocator());
+    vector3.PushBack(value.y, root.GetAllocator());
+    vector3.PushBack(value.z, root.GetAllocator());
+
+    Value name(memberName.c_str(), SizeType(memberName.size()), root.GetAllocator());
+    Get_Member_Object(valueName).AddMember(name, vector3, root.GetAllocator());
+}
+
+#ifdef PENGINE_DOUBLE_PRECISION
+/**
+ * @brief Write a Vec3 inside of an object in root without rounding it to
+ *        float (the object is made if it isn't there yet)
+ * 
+ * @param valueName Name of the object
+ * @param memberName Name of the Vec3
+ * @param value Vec3 to write
+ */
+void File_Writer::Write_Member_Vec3(std::string valueName, std::string memberName, const Vec3& value) {
+    Value vector3(kArrayType);
+    vector3.PushBack(value.x, root.GetAllocator());
+    vector3.PushBack(value.y, root.GetAllocator());
+    vector3.PushBack(value.z, root.GetAllocator());
+
+    Value name(memberName.c_str(), SizeType(memberName.size()), root.GetAllocator());
+    Get_Member_Object(valueName).AddMember(name, vector3, root.GetAllocator());
+}
+#endif
+
+/**
+ * @brief Write a std::string inside of an object in root (the object is made
+ *        if it isn't there yet)
+ * 
+ * @param valueName Name of the object
+ * @param memberName Name of the std::string
+ * @param value 
+ */
+void File_Writer::Write_Member_String(std::string valueName, std::string memberName, std::string value) {
+    Value name(memberName.c_str(), SizeType(memberName.size()), root.GetAllocator());
+    Value newValue(value.c_str(), SizeType(value.size()), root.GetAllocator());
+
+    Get_Member_Object(valueName).AddMember(name, newValue, root.GetAllocator());
+}
+
 /**
  * @brief Writing behaviorNames into nested object and then into root
  * 
  * @param behaviorNames 
  */
-void File_Writer::Write_Behavior_Name(std::vector<std::string>& behaviorNames) {
+void File_Writer::Write_Behavior_Name(const std::vector<std::string>& behaviorNames) {
     Value behaviors(kObjectType);
 
       // Filling object
@@ -104,13 +187,14 @@ void File_Writer::Write_Behavior_Name(std::vector<std::string>& behaviorNames) {
  * @brief Writing data of an object into root
  * 
  * @param object 
+ * @param objectNum Position of the object in the preset list
  */
-void File_Writer::Write_Object_Data(Object* object) {
+void File_Writer::Write_Object_Data(Object* object, unsigned objectNum) {
     if (!object) return;
 
       // Getting transform data from object
     Transform* transform = object->GetComponent<Transform>();
-    glm::vec3 startPos = { 0.f, 0.f, 0.f };
+    Vec3 startPos(0);
     glm::vec3 startScale = { 1.f, 1.f, 1.f };
     if (transform) startPos = transform->GetStartPosition();
     if (transform) startScale = transform->GetScale();
@@ -138,7 +222,70 @@ void File_Writer::Write_Object_Data(Object* object) {
     objectData.AddMember(StringRef("scale"), scale, root.GetAllocator());
 
       // Nesting object into root
-    std::string objectIdName = "object_" + std::to_string(object->GetId());
+    std::string objectIdName = "object_" + std::to_string(objectNum);
+    Value name(objectIdName.c_str(), SizeType(objectIdName.size()), root.GetAllocator());
+    root.AddMember(name, objectData, root.GetAllocator());
+}
+
+/**
+ * @brief Writing where an object is and how it is moving into root (used to
+ *        save the end of a run, not read back in as a preset)
+ * 
+ * @param object 
+ * @param objectNum Position of the object in the object list
+ */
+void File_Writer::Write_Object_State(Object* object, unsigned objectNum) {
+    if (!object) return;
+
+      // Getting the current state from the object's components
+    Transform* transform = object->GetComponent<Transform>();
+    Physics* physics = object->GetComponent<Physics>();
+    Vec3 position(0);
+    Vec3 velocity(0);
+    Real mass = Real(0);
+    if (transform) position = transform->GetPosition();
+    if (physics) velocity = physics->GetVelocity();
+    if (physics) mass = physics->GetMass();
+
+      // Putting position into value rapidjson can use
+    Value pos(kArrayType);
+    pos.PushBack(position.x, root.GetAllocator());
+    pos.PushBack(position.y, root.GetAllocator());
+    pos.PushBack(position.z, root.GetAllocator());
+
+      // Putting velocity into value rapidjson can use
+    Value vel(kArrayType);
+    vel.PushBack(velocity.x, root.GetAllocator());
+    vel.PushBack(velocity.y, root.GetAllocator());
+    vel.PushBack(velocity.z, root.GetAllocator());
+
+      // Creating and filling object
+    Value objectData(kObjectType);
+
+    Value objectName(object->GetName().c_str(), SizeType(object->GetName().size()), root.GetAllocator());
+    objectData.AddMember(StringRef("objectName"), objectName, root.GetAllocator());
+    objectData.AddMember(StringRef("position"), pos, root.GetAllocator());
+    objectData.AddMember(StringRef("velocity"), vel, root.GetAllocator());
+    objectData.AddMember(StringRef("mass"), mass, root.GetAllocator());
+
+      // Nesting object into root
+    std::string objectIdName = "state_" + std::to_string(objectNum);
     Value name(objectIdName.c_str(), SizeType(objectIdName.size()), root.GetAllocator());
     root.AddMember(name, objectData, root.GetAllocator());
 }
+
+/**
+ * @brief Returns the object in root with the given name, making it first if
+ *        it isn't there
+ * 
+ * @param valueName Name of the object
+ * @return Value& 
+ */
+Value& File_Writer::Get_Member_Object(std::string valueName) {
+    if (!root.HasMember(valueName.c_str())) {
+        Value name(valueName.c_str(), SizeType(valueName.size()), root.GetAllocator());
+        root.AddMember(name, Value(kObjectType), root.GetAllocator());
+    }
+
+    return root[valueName.c_str()];
+}
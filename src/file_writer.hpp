@@ -25,14 +25,18 @@
 
 // Engine includes //
 #include "object.hpp"
+#include "precision.hpp"
 
 /*! File_Writer class */
 class File_Writer {
     public:
         File_Writer();
-        void Write_File(std::string filename);
+        bool Write_File(std::string filename, bool isFullPrecision = false);
 
         void Write_Vec3(std::string valueName, glm::vec3 value);
+#ifdef PENGINE_DOUBLE_PRECISION
+        void Write_Vec3(std::string valueName, const Vec3& value);
+#endif
         void Write_String(std::string valueName, std::string value);
         
         /**
@@ -48,8 +52,32 @@ class File_Writer {
             root.AddMember(name, value, root.GetAllocator());
         }
 
-        void Write_Behavior_Name(std::vector<std::string>& behaviorNames);
-        void Write_Object_Data(Object* object);
+        void Write_Member_Vec3(std::string valueName, std::string memberName, glm::vec3 value);
+#ifdef PENGINE_DOUBLE_PRECISION
+        void Write_Member_Vec3(std::string valueName, std::string memberName, const Vec3& value);
+#endif
+        void Write_Member_String(std::string valueName, std::string memberName, std::string value);
+
+        /**
+         * @brief Writes most values inside of an object in root (can't do
+         *        strings). The object is made if it isn't there yet
+         * 
+         * @tparam T 
+         * @param valueName Name of the object
+         * @param memberName Name of the value inside of the object
+         * @param value Value being written
+         */
+        template <typename T>
+        void Write_Member_Value(std::string valueName, std::string memberName, T value) {
+            rapidjson::Value name(memberName.c_str(), rapidjson::SizeType(memberName.size()), root.GetAllocator());
+            Get_Member_Object(valueName).AddMember(name, value, root.GetAllocator());
+        }
+
+        void Write_Behavior_Name(const std::vector<std::string>& behaviorNames);
+        void Write_Object_Data(Object* object, unsigned objectNum);
+        void Write_Object_State(Object* object, unsigned objectNum);
+    private:
+        rapidjson::Value& Get_Member_Object(std::string valueName);
     private:
         rapidjson::Document root; //!< Holds the data for the json file
 };
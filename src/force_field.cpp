@@ -0,0 +1,204 @@
+/**
+ * @file force_field.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// std includes //
+#include <cmath>
+#include <string>
+
+// Library includes //
+#include <glm.hpp>
+
+// Engine includes //
+  // System //
+#include "force_field.hpp"
+#include "job_system.hpp"
+  // Component //
+#include "component_storage.hpp"
+#include "physics.hpp"
+  // Misc //
+#include "trace.hpp"
+
+static Force_Field* force_field = nullptr; //!< Force_Field object
+
+const char* Force_Field::typeNames[TypeCount] = { "gravity", "uniform", "drag", "attractor" };
+
+/**
+ * @brief Initializes the force fields with the fields the preset declares
+ *        ("field_0", "field_1", ...)
+ *
+ * @param preset Preset being loaded
+ * @return true
+ * @return false
+ */
+bool Force_Field::Initialize(File_Reader& preset) {
+    if (!Initialize()) return false;
+
+    force_field->Read(preset);
+    return true;
+}
+
+/**
+ * @brief Initializes the force fields with no fields
+ *
+ * @return true
+ * @return false
+ */
+bool Force_Field::Initialize() {
+      // Initializing force_field
+    force_field = new Force_Field;
+    if (!force_field) {
+        Trace::Message("Force Field was not initialized.\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Adds the force of every field to every body with Physics (spread
+ *        over the job system). Called once per step after the scripts and
+ *        before the Integrator, which holds the forces for the whole step.
+ *        Mutual gravity is only marked here, the Integrator finds it for all
+ *        bodies at once wherever its method needs it (a body that also calls
+ *        UpdateGravity from a script is still only pulled once)
+ *
+ * @return void
+ */
+void Force_Field::Update() {
+    if (!force_field || force_field->fields.empty()) return;
+
+    Job_System::ParallelFor(Component_Storage::GetEntityCount(), 1024, [](unsigned begin, unsigned end) {
+        Physics_Data& physics = Component_Storage::GetPhysicsData();
+        const Transform_Data& transforms = Component_Storage::GetTransformData();
+
+        Component_Storage::ForEach<Physics>(begin, end, [&](unsigned i, Physics&) {
+            Vec3 force(0);
+            for (const Field& field : force_field->fields) {
+                switch (field.type) {
+                    case MutualGravity:
+                        physics.usesGravity[i] = 1;
+                        break;
+                    case UniformGravity:
+                        force += field.vector * physics.mass[i];
+                        break;
+                    case LinearDrag:
+                        force -= physics.velocity[i] * field.strength;
+                        break;
+                    case PointAttractor: {
+                          // Objects without a Transform have no position to be pulled from
+                        if (!transforms.isUsed[i]) break;
+                        Vec3 offset = field.vector - transforms.position[i];
+                        Real distanceSq = glm::dot(offset, offset) + field.softening * field.softening;
+                        if (distanceSq <= Real(0)) break;
+                        force += offset * (field.strength * physics.mass[i] / (distanceSq * std::sqrt(distanceSq)));
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+
+              // Untouched bodies keep zero forces so sleeping ones stay asleep
+            if (force != Vec3(0)) physics.forces[i] += force;
+        });
+    });
+}
+
+/**
+ * @brief Deletes the force_field object
+ *
+ * @return void
+ */
+void Force_Field::Shutdown() {
+    if (!force_field) return;
+
+    delete force_field;
+    force_field = nullptr;
+}
+
+/**
+ * @brief Gives the fields to the writer
+ *
+ * @param writer
+ * @return void
+ */
+void Force_Field::Write(File_Writer& writer) {
+    for (unsigned i = 0; i < force_field->fields.size(); ++i) {
+        const Field& field = force_field->fields[i];
+        std::string fieldName = "field_" + std::to_string(i);
+
+        writer.Write_Member_String(fieldName, "type", typeNames[field.type]);
+        switch (field.type) {
+            case UniformGravity:
+                writer.Write_Member_Vec3(fieldName, "acceleration", field.vector);
+                break;
+            case LinearDrag:
+                writer.Write_Member_Value(fieldName, "strength", field.strength);
+                break;
+            case PointAttractor:
+                writer.Write_Member_Vec3(fieldName, "position", field.vector);
+                writer.Write_Member_Value(fieldName, "strength", field.strength);
+                writer.Write_Member_Value(fieldName, "softening", field.softening);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Returns the number of fields
+ *
+ * @return unsigned
+ */
+unsigned Force_Field::GetFieldCount() { return force_field->fields.size(); }
+
+/**
+ * @brief Returns the type of the field at the given index
+ *
+ * @param index Index of the field (0 to GetFieldCount())
+ * @return Force_Field::Type
+ */
+Force_Field::Type Force_Field::GetFieldType(unsigned index) {
+    if (index >= force_field->fields.size()) return TypeCount;
+    return force_field->fields[index].type;
+}
+
+/**
+ * @brief Reads the fields of the preset. Unknown types are skipped
+ *
+ * @param preset Preset being loaded
+ */
+void Force_Field::Read(File_Reader& preset) {
+    for (unsigned field_num = 0; ; ++field_num) {
+        std::string fieldName = "field_" + std::to_string(field_num);
+        std::string typeName = preset.Read_Member_String(fieldName, "type");
+        if (typeName.empty()) break;
+
+        Field field;
+        field.type = TypeCount;
+        for (unsigned i = 0; i < TypeCount; ++i) {
+            if (typeName == typeNames[i]) field.type = Type(i);
+        }
+        if (field.type == TypeCount) {
+            Trace::Message("Unknown field type '" + typeName + "' in " + fieldName + ", skipping it.\n");
+            continue;
+        }
+
+        field.vector = Vec3(0);
+        field.strength = preset.Read_Member_Real(fieldName, "strength");
+        field.softening = preset.Read_Member_Real(fieldName, "softening");
+        if (field.type == UniformGravity) field.vector = preset.Read_Member_Real_Vec3(fieldName, "acceleration");
+        if (field.type == PointAttractor) field.vector = preset.Read_Member_Real_Vec3(fieldName, "position");
+
+        fields.emplace_back(field);
+    }
+}
@@ -0,0 +1,60 @@
+/**
+ * @file force_field.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-17
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef FORCE_FIELD_HPP
+#define FORCE_FIELD_HPP
+
+// std includes //
+#include <vector>
+
+// Engine includes //
+#include "file_reader.hpp"
+#include "file_writer.hpp"
+#include "precision.hpp"
+
+/*! Force_Field class (forces on every body declared by the preset, added in one pass each step) */
+class Force_Field {
+    public:
+        /*! Kind of field */
+        enum Type {
+            MutualGravity,  //!< Every body pulls on every other body (uses gravConst)
+            UniformGravity, //!< Same acceleration on every body
+            LinearDrag,     //!< Force against the velocity, strength times the velocity
+            PointAttractor, //!< Pull towards a point, strength over distance squared
+            TypeCount
+        };
+
+        static const char* typeNames[TypeCount]; //!< Name of each type (used in presets)
+
+        static bool Initialize(File_Reader& preset);
+        static bool Initialize();
+        static void Update();
+        static void Shutdown();
+        static void Write(File_Writer& writer);
+
+        static unsigned GetFieldCount();
+        static Type GetFieldType(unsigned index);
+    private:
+        /*! One field from the preset */
+        struct Field {
+            Type type;      //!< Kind of field
+            Vec3 vector;    //!< Acceleration (uniform gravity) or point pulled towards (attractor)
+            Real strength;  //!< Drag coefficient, or G times the mass of the attractor
+            Real softening; //!< Distance that keeps an attractor's pull finite close to its point
+        };
+
+        void Read(File_Reader& preset);
+    private:
+        std::vector<Field> fields; //!< Fields added to the bodies each step (in preset order)
+};
+
+#endif
@@ -27,9 +27,11 @@
   // System //
 #include "engine.hpp"
 #include "graphics.hpp"
+#include "job_system.hpp"
   // Object //
 #include "object_manager.hpp"
   // Component //
+#include "component_storage.hpp"
 #include "model.hpp"
 #include "transform.hpp"
   // Misc //
@@ -232,15 +234,17 @@ void Graphics::Render() {
         Camera::GetPosition() + Camera::GetFront(), 
         Camera::GetUp());
 
-      // Rendering all of the objects
-    for (unsigned i = 0; i < Object_Manager::GetSize(); ++i) {
-        Object* object = Object_Manager::FindObject(i);
+      // Remaking the world matrices of objects that moved and blending them
+      // between the last two physics steps, spread over the workers
+    float alpha = Engine::GetAlpha();
+    Job_System::ParallelFor(Component_Storage::GetEntityCount(), 1024, [alpha](unsigned begin, unsigned end) {
+        Transform::UpdateRenderMatrices(begin, end, alpha);
+    });
 
-        Model* model = object->GetComponent<Model>();
-        if (!model) continue;
-        
-        model->Draw(projection, view);
-    }
+      // Rendering all of the objects
+    Component_Storage::ForEach<Model, Transform>([&projection, &view](unsigned, Model& model, Transform& transform) {
+        model.Draw(&transform, projection, view);
+    });
 
     Editor::Render();
 
@@ -0,0 +1,283 @@
+/**
+ * @file gravity.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-02
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// Engine includes //
+  // System //
+#include "direct_gravity.hpp"
+#include "engine.hpp"
+#include "gravity.hpp"
+#include "job_system.hpp"
+  // Component //
+#include "component_storage.hpp"
+#include "physics.hpp"
+#include "transform.hpp"
+  // Misc //
+#include "trace.hpp"
+
+static Gravity* gravity = nullptr; //!< Gravity object
+
+/**
+ * @brief Initializes the gravity system using the settings of the preset
+ *
+ * @param preset Preset being loaded
+ * @return true
+ * @return false
+ */
+bool Gravity::Initialize(File_Reader& preset) {
+    if (!Initialize()) return false;
+
+    gravity->openingAngle = preset.Read_Float("openingAngle");
+    if (gravity->openingAngle < 0.f) gravity->openingAngle = 0.f;
+    int meshSize = preset.Read_Int("meshSize");
+    if (meshSize > 0) gravity->mesh.SetSize(unsigned(meshSize));
+
+    return true;
+}
+
+/**
+ * @brief Initializes the gravity system with default values (exact forces)
+ *
+ * @return true
+ * @return false
+ */
+bool Gravity::Initialize() {
+      // Initializing gravity
+    gravity = new Gravity;
+    if (!gravity) {
+        Trace::Message("Gravity was not initialized.\n");
+        return false;
+    }
+
+    gravity->gravConst = Real(0);
+    gravity->openingAngle = 0.f;
+    gravity->generation = 0;
+
+    return true;
+}
+
+/**
+ * @brief Deletes the gravity object
+ *
+ * @return void
+ */
+void Gravity::Shutdown() {
+    if (!gravity) return;
+
+    delete gravity;
+    gravity = nullptr;
+}
+
+/**
+ * @brief Gives the gravity settings to the writer
+ *
+ * @param writer
+ * @return void
+ */
+void Gravity::Write(File_Writer& writer) {
+    writer.Write_Value("openingAngle", gravity->openingAngle);
+    writer.Write_Value("meshSize", int(gravity->mesh.GetSize()));
+}
+
+/**
+ * @brief Finds the pull on every body with the bodies at the given positions
+ *        instead of their Transforms (used by integrators that look at the
+ *        bodies part way through a step)
+ *
+ * @param positions Position of each entity (index is the entity)
+ * @return void
+ */
+void Gravity::Compute(const Vec3* positions) {
+    gravity->Build(positions);
+}
+
+/**
+ * @brief Finds the pull on only the given entities, from every body at the
+ *        given positions (block timesteps, where few bodies are due at once).
+ *        The acceleration of any other entity is left at 0
+ *
+ * @param positions Position of each entity (index is the entity)
+ * @param entities Entities whose pull is found
+ * @return void
+ */
+void Gravity::Compute(const Vec3* positions, const std::vector<unsigned>& entities) {
+    gravity->Build(positions, &entities);
+}
+
+/**
+ * @brief Returns the gravitational acceleration of the entity from the last
+ *        Compute. Safe to call from any thread once it is found
+ *
+ * @param entity
+ * @return Vec3
+ */
+Vec3 Gravity::GetAcceleration(unsigned entity) {
+    if (entity >= gravity->bodies.size()) return Vec3(0);
+    int body = gravity->bodies[entity];
+    if (body == -1) return Vec3(0);
+
+    Vec3 acceleration(gravity->accelX[body], gravity->accelY[body], gravity->accelZ[body]);
+    return acceleration * gravity->gravConst;
+}
+
+/**
+ * @brief Marks every pull found so far as stale. Called whenever a body is
+ *        moved, weighed again, added or removed outside the Integrator
+ *
+ * @return void
+ */
+void Gravity::MarkChanged() {
+    if (gravity) ++gravity->generation;
+}
+
+/**
+ * @brief Returns the generation of the bodies (pulls found in an older
+ *        generation can't be reused)
+ *
+ * @return unsigned
+ */
+unsigned Gravity::GetGeneration() { return gravity->generation; }
+
+/**
+ * @brief Returns reference to the opening angle (0 means exact forces)
+ *
+ * @return float&
+ */
+float& Gravity::GetOpeningAngle() { return gravity->openingAngle; }
+
+/**
+ * @brief Returns the number of cells along each side of the mesh (0 when the
+ *        tree or exact forces are used)
+ *
+ * @return unsigned
+ */
+unsigned Gravity::GetMeshSize() { return gravity->mesh.GetSize(); }
+
+/**
+ * @brief Sets the number of cells along each side of the mesh, rounded up to
+ *        a power of two (0 goes back to the tree or exact forces)
+ *
+ * @param meshSize
+ * @return void
+ */
+void Gravity::SetMeshSize(unsigned meshSize) { gravity->mesh.SetSize(meshSize); }
+
+/**
+ * @brief Packs the position and mass of every object into arrays and finds the
+ *        acceleration of every body, or only of the given entities, with the
+ *        mesh, the tree or exact pairs (spread over the job system)
+ *
+ * @param bodyPositions Position of each entity (index is the entity)
+ * @param entities Entities whose acceleration is found (nullptr for all)
+ */
+void Gravity::Build(const Vec3* bodyPositions, const std::vector<unsigned>* entities) {
+    gravConst = Real(Engine::GetGravConst());
+    positions.clear();
+    posX.clear();
+    posY.clear();
+    posZ.clear();
+    masses.clear();
+    const bool useMesh = mesh.GetSize() > 0;
+    const bool useTree = !useMesh && openingAngle > 0.f;
+
+      // Packing every entity with physics into the body arrays
+    const Physics_Data& physics = Component_Storage::GetPhysicsData();
+    unsigned entityCount = Component_Storage::GetEntityCount();
+    bodies.assign(entityCount, -1);
+    Component_Storage::ForEach<Physics, Transform>([&](unsigned i, Physics&, Transform&) {
+        Vec3 position = bodyPositions[i];
+        bodies[i] = (int)masses.size();
+        masses.emplace_back(physics.mass[i]);
+        if (useTree) {
+            positions.emplace_back(position);
+        }
+        else {
+            posX.emplace_back(position.x);
+            posY.emplace_back(position.y);
+            posZ.emplace_back(position.z);
+        }
+    });
+
+    unsigned count = masses.size();
+    accelX.assign(count, Real(0));
+    accelY.assign(count, Real(0));
+    accelZ.assign(count, Real(0));
+
+    if (useMesh) {
+          // The grid costs the same however many bodies are asked for, so
+          // every body is found
+        tree.Clear();
+        mesh.Compute(posX.data(), posY.data(), posZ.data(), masses.data(),
+            accelX.data(), accelY.data(), accelZ.data(), count);
+    }
+    else if (entities) {
+        targets.clear();
+        for (unsigned entity : *entities) {
+            if (entity < entityCount && bodies[entity] != -1) targets.emplace_back(bodies[entity]);
+        }
+
+          // Each target is written by one thread, so the pairs aren't shared
+        if (useTree) {
+            tree.Build(positions, masses);
+            Job_System::ParallelFor(targets.size(), 64, [this](unsigned begin, unsigned end) {
+                for (unsigned k = begin; k < end; ++k) {
+                    unsigned body = targets[k];
+                    Vec3 acceleration = tree.ComputeAcceleration(body, Real(openingAngle));
+                    accelX[body] = acceleration.x;
+                    accelY[body] = acceleration.y;
+                    accelZ[body] = acceleration.z;
+                }
+            });
+        }
+        else {
+            tree.Clear();
+            Job_System::ParallelFor(targets.size(), 32, [this, count](unsigned begin, unsigned end) {
+                Direct_Gravity::ComputeFor(posX.data(), posY.data(), posZ.data(), masses.data(),
+                    accelX.data(), accelY.data(), accelZ.data(), targets.data(), begin, end, count);
+            });
+        }
+    }
+    else if (useTree) {
+          // Tree is built once and reused by every body's query
+        tree.Build(positions, masses);
+        Job_System::ParallelFor(count, 64, [this](unsigned begin, unsigned end) {
+            for (unsigned body = begin; body < end; ++body) {
+                Vec3 acceleration = tree.ComputeAcceleration(body, Real(openingAngle));
+                accelX[body] = acceleration.x;
+                accelY[body] = acceleration.y;
+                accelZ[body] = acceleration.z;
+            }
+        });
+    }
+    else {
+        tree.Clear();
+
+          // Exact forces, each thread adds its pairs into its own arrays
+        unsigned threads = Job_System::GetThreadCount();
+        threadAccel.assign(threads * 3 * count, Real(0));
+        Job_System::ParallelFor(count, 32, [this, count](unsigned begin, unsigned end) {
+            Real* own = threadAccel.data() + Job_System::GetThreadIndex() * 3 * count;
+            Direct_Gravity::Compute(posX.data(), posY.data(), posZ.data(), masses.data(),
+                own, own + count, own + 2 * count, begin, end, count);
+        });
+
+          // Adding up the arrays of each thread
+        Job_System::ParallelFor(count, 1024, [this, count, threads](unsigned begin, unsigned end) {
+            for (unsigned thread = 0; thread < threads; ++thread) {
+                const Real* own = threadAccel.data() + thread * 3 * count;
+                for (unsigned body = begin; body < end; ++body) {
+                    accelX[body] += own[body];
+                    accelY[body] += own[count + body];
+                    accelZ[body] += own[2 * count + body];
+                }
+            }
+        });
+    }
+}
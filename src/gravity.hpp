@@ -0,0 +1,66 @@
+/**
+ * @file gravity.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-02
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef GRAVITY_HPP
+#define GRAVITY_HPP
+
+// std includes //
+#include <vector>
+
+// Library includes //
+#include <vec3.hpp>
+
+// Engine includes //
+#include "file_reader.hpp"
+#include "file_writer.hpp"
+#include "octree.hpp"
+#include "particle_mesh.hpp"
+#include "precision.hpp"
+
+/*! Gravity class */
+class Gravity {
+    public:
+        static bool Initialize(File_Reader& preset);
+        static bool Initialize();
+        static void Shutdown();
+        static void Write(File_Writer& writer);
+
+        static void Compute(const Vec3* positions);
+        static void Compute(const Vec3* positions, const std::vector<unsigned>& entities);
+        static Vec3 GetAcceleration(unsigned entity);
+        static void MarkChanged();
+        static unsigned GetGeneration();
+        static float& GetOpeningAngle();
+        static unsigned GetMeshSize();
+        static void SetMeshSize(unsigned meshSize);
+    private:
+        void Build(const Vec3* bodyPositions, const std::vector<unsigned>* entities = nullptr);
+    private:
+        Octree tree;                    //!< Barnes-Hut tree over the bodies
+        Particle_Mesh mesh;             //!< Grid the pull is found on (when it has a size)
+        std::vector<Vec3> positions;    //!< Position of each body this step (tree)
+        std::vector<Real> posX;         //!< Position of each body this step (x, exact)
+        std::vector<Real> posY;         //!< Position of each body this step (y, exact)
+        std::vector<Real> posZ;         //!< Position of each body this step (z, exact)
+        std::vector<Real> accelX;       //!< Acceleration of each body this step (x)
+        std::vector<Real> accelY;       //!< Acceleration of each body this step (y)
+        std::vector<Real> accelZ;       //!< Acceleration of each body this step (z)
+        std::vector<Real> threadAccel;  //!< Acceleration added by each thread (exact)
+        std::vector<Real> masses;       //!< Mass of each body this step
+        std::vector<int> bodies;        //!< Body index of each entity (-1 if it has no body)
+        std::vector<unsigned> targets;  //!< Bodies whose acceleration is found (when only some are)
+        Real gravConst;                 //!< Gravitational constant this step (read once per build)
+        float openingAngle;             //!< Barnes-Hut opening angle (0 is exact)
+        unsigned generation;            //!< Changes whenever a body is moved or weighed outside the Integrator
+};
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file hash_grid.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-19
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// std includes //
+#include <numeric>
+
+// Engine includes //
+#include "hash_grid.hpp"
+
+/**
+ * @brief Creates an empty grid
+ *
+ */
+Hash_Grid::Hash_Grid() : positions(nullptr), cellSize(Real(0)), mask(0) {}
+
+/**
+ * @brief Sorts the bodies into the buckets of their cells. The positions need
+ *        to stay alive until the grid is built again
+ *
+ * @param positions_ Position of each body
+ * @param cellSize_ Width of a cell (bodies further apart than this are never
+ *        in neighboring cells)
+ */
+void Hash_Grid::Build(const std::vector<Vec3>& positions_, Real cellSize_) {
+    positions = &positions_;
+    cellSize = cellSize_;
+    unsigned count = positions->size();
+
+      // Twice as many buckets as bodies keeps buckets mostly to one cell
+    unsigned bucketCount = 1;
+    while (bucketCount < 2 * count) bucketCount <<= 1;
+    mask = bucketCount - 1;
+
+      // Counting sort of the bodies by bucket. After it the bodies of bucket
+      // k are sortedBodies[cellStart[k]] to sortedBodies[cellStart[k + 1]]
+    cellStart.assign(bucketCount + 1, 0);
+    for (unsigned body = 0; body < count; ++body) {
+        ++cellStart[Bucket(Cell((*positions)[body]))];
+    }
+    std::partial_sum(cellStart.begin(), cellStart.end(), cellStart.begin());
+    sortedBodies.resize(count);
+    for (unsigned body = 0; body < count; ++body) {
+        sortedBodies[--cellStart[Bucket(Cell((*positions)[body]))]] = body;
+    }
+}
+
+/**
+ * @brief Returns the grid cell the position is in
+ *
+ * @param position
+ * @return glm::ivec3
+ */
+glm::ivec3 Hash_Grid::Cell(Vec3 position) const {
+    return glm::ivec3(glm::floor(position / cellSize));
+}
+
+/**
+ * @brief Returns the hash bucket of the cell
+ *
+ * @param cell
+ * @return unsigned
+ */
+unsigned Hash_Grid::Bucket(glm::ivec3 cell) const {
+    return ((unsigned(cell.x) * 73856093u) ^ (unsigned(cell.y) * 19349663u) ^ (unsigned(cell.z) * 83492791u)) & mask;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file hash_grid.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-19
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef HASH_GRID_HPP
+#define HASH_GRID_HPP
+
+// std includes //
+#include <algorithm>
+#include <vector>
+
+// Library includes //
+#include <glm.hpp>
+
+// Engine includes //
+#include "precision.hpp"
+
+/*! Hash_Grid class (uniform grid of cells hashed into buckets, used to find
+    the bodies near each body) */
+class Hash_Grid {
+    public:
+        Hash_Grid();
+
+        void Build(const std::vector<Vec3>& positions_, Real cellSize_);
+
+        /**
+         * @brief Calls function(b) for every body b (other than a) in the 27
+         *        cells around body a. Bodies in cells that share a bucket with
+         *        those cells are passed too, so callers still check distances
+         *
+         * @tparam Function
+         * @param a Body to look around
+         * @param function Called with each body found
+         */
+        template <typename Function>
+        void ForEachNear(unsigned a, Function&& function) const {
+            glm::ivec3 cell = Cell((*positions)[a]);
+            unsigned visited[27];
+            unsigned visitedCount = 0;
+
+            for (int x = -1; x <= 1; ++x) {
+                for (int y = -1; y <= 1; ++y) {
+                    for (int z = -1; z <= 1; ++z) {
+                          // Different cells can share a bucket, each bucket is
+                          // only looked through once
+                        unsigned bucket = Bucket(cell + glm::ivec3(x, y, z));
+                        if (std::find(visited, visited + visitedCount, bucket) != visited + visitedCount) continue;
+                        visited[visitedCount++] = bucket;
+
+                        for (unsigned k = cellStart[bucket]; k < cellStart[bucket + 1]; ++k) {
+                            unsigned b = sortedBodies[k];
+                            if (b != a) function(b);
+                        }
+                    }
+                }
+            }
+        }
+    private:
+        glm::ivec3 Cell(Vec3 position) const;
+        unsigned Bucket(glm::ivec3 cell) const;
+    private:
+        std::vector<unsigned> cellStart;    //!< First sorted body of each hash bucket
+        std::vector<unsigned> sortedBodies; //!< Bodies sorted by bucket
+        const std::vector<Vec3>* positions; //!< Positions of the bodies in the grid
+        Real cellSize;                      //!< Width of a cell
+        unsigned mask;                      //!< Bucket count - 1
+};
+
+#endif
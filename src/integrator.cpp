@@ -0,0 +1,627 @@
+/**
+ * @file integrator.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-13
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// std includes //
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// Engine includes //
+  // System //
+#include "engine.hpp"
+#include "gravity.hpp"
+#include "integrator.hpp"
+#include "job_system.hpp"
+  // Component //
+#include "physics.hpp"
+#include "transform.hpp"
+  // Misc //
+#include "trace.hpp"
+
+static Integrator* integrator = nullptr; //!< Integrator object
+
+const char* Integrator::methodNames[MethodCount] = { "euler", "leapfrog", "verlet", "rk4", "block" };
+
+static const float defaultSleepVelocity = 0.05f; //!< Speed below which a body counts as resting
+static const float defaultSleepDelay = 1.f;      //!< Seconds a body rests before it sleeps
+static const int defaultMaxBlockLevel = 6;       //!< Longest block is 64 steps
+static const int highestBlockLevel = 16;         //!< Highest maxBlockLevel a preset can ask for
+static const float defaultBlockAccuracy = 0.02f; //!< Fraction of |v| / |a| a block may last
+
+/**
+ * @brief Sets the Transform of the entity to its new position and turns it by
+ *        its rotational velocity (end of every method)
+ *
+ */
+static inline void MoveTransform(Transform_Data& transforms, const Physics_Data& physics, unsigned i,
+    Vec3 position, Real dt) {
+      // Objects at rest keep their world matrix
+    if (position != transforms.position[i] || physics.rotationalVelocity[i] != glm::vec3(0.f))
+        transforms.isDirty[i] = 1;
+
+    transforms.oldPosition[i] = transforms.position[i];
+    transforms.position[i] = position;
+    transforms.oldRotation[i] = transforms.rotation[i];
+    transforms.rotation[i] += physics.rotationalVelocity[i] * float(dt);
+    transforms.isStepped[i] = 1;
+}
+
+/**
+ * @brief Turns the forces on the entity into its acceleration for the step
+ *
+ */
+static inline void Prepare(Physics_Data& physics, unsigned i) {
+    physics.acceleration[i] = physics.forces[i] / physics.mass[i];
+    physics.heldForces[i] = physics.forces[i];
+    physics.forces[i] = Vec3(0);
+}
+
+/**
+ * @brief Initializes the integrator using the method named by the preset
+ *        (Euler when it doesn't name one)
+ *
+ * @param preset Preset being loaded
+ * @return true
+ * @return false
+ */
+bool Integrator::Initialize(File_Reader& preset) {
+    if (!Initialize()) return false;
+
+    integrator->allowSleeping = preset.Read_Bool("allowSleeping");
+    integrator->sleepVelocity = preset.Read_Float("sleepVelocity");
+    if (integrator->sleepVelocity <= 0.f) integrator->sleepVelocity = defaultSleepVelocity;
+    integrator->sleepDelay = preset.Read_Float("sleepDelay");
+    if (integrator->sleepDelay <= 0.f) integrator->sleepDelay = defaultSleepDelay;
+    int maxBlockLevel = preset.Read_Int("maxBlockLevel");
+    if (maxBlockLevel > 0) integrator->maxBlockLevel = std::min(maxBlockLevel, highestBlockLevel);
+    integrator->blockAccuracy = preset.Read_Float("blockAccuracy");
+    if (integrator->blockAccuracy <= 0.f) integrator->blockAccuracy = defaultBlockAccuracy;
+
+    std::string methodName = preset.Read_String("integrator");
+    if (methodName.empty()) return true;
+
+    for (unsigned i = 0; i < MethodCount; ++i) {
+        if (methodName == methodNames[i]) {
+            integrator->method = Method(i);
+            return true;
+        }
+    }
+
+    Trace::Message("Unknown integrator '" + methodName + "', using euler.\n");
+    return true;
+}
+
+/**
+ * @brief Initializes the integrator with semi-implicit Euler
+ *
+ * @return true
+ * @return false
+ */
+bool Integrator::Initialize() {
+      // Initializing integrator
+    integrator = new Integrator;
+    if (!integrator) {
+        Trace::Message("Integrator was not initialized.\n");
+        return false;
+    }
+
+    integrator->method = Euler;
+    integrator->needsGravity = false;
+    integrator->allowSleeping = false;
+    integrator->sleepVelocity = defaultSleepVelocity;
+    integrator->sleepDelay = defaultSleepDelay;
+    integrator->sleepingCount = 0;
+    integrator->maxBlockLevel = defaultMaxBlockLevel;
+    integrator->blockAccuracy = defaultBlockAccuracy;
+    integrator->blockTick = 0;
+    integrator->pullCount = 0;
+    integrator->bodyCount = 0;
+    integrator->endGravityGeneration = 0;
+    integrator->endGravityConst = 0.0;
+
+    return true;
+}
+
+/**
+ * @brief Deletes the integrator object
+ *
+ * @return void
+ */
+void Integrator::Shutdown() {
+    if (!integrator) return;
+
+    delete integrator;
+    integrator = nullptr;
+}
+
+/**
+ * @brief Gives the method being used to the writer
+ *
+ * @param writer
+ * @return void
+ */
+void Integrator::Write(File_Writer& writer) {
+    writer.Write_String("integrator", methodNames[integrator->method]);
+    writer.Write_Value("allowSleeping", integrator->allowSleeping);
+    writer.Write_Value("sleepVelocity", integrator->sleepVelocity);
+    writer.Write_Value("sleepDelay", integrator->sleepDelay);
+    writer.Write_Value("maxBlockLevel", int(integrator->maxBlockLevel));
+    writer.Write_Value("blockAccuracy", integrator->blockAccuracy);
+}
+
+/**
+ * @brief Moves every object with Physics forward one fixed step using the
+ *        forces added during the step. Forces added by scripts are held for
+ *        the whole step, gravity is found again wherever the method needs it
+ *
+ * @return void
+ */
+void Integrator::Step() {
+    unsigned entityCount = Component_Storage::GetEntityCount();
+
+      // Only bodies moved by this step are blended when drawn
+    Transform_Data& transforms = Component_Storage::GetTransformData();
+    std::fill(transforms.isStepped.begin(), transforms.isStepped.end(), 0);
+
+      // Only awake bodies are stepped, gravity passes are skipped when none of
+      // them asked for it
+    integrator->FindAwake(entityCount);
+    if (integrator->awake.empty()) return;
+
+    switch (integrator->method) {
+        case Leapfrog: integrator->StepLeapfrog(); break;
+        case Verlet:   integrator->StepVerlet();   break;
+        case RK4:      integrator->StepRK4();      break;
+        case Block:    integrator->StepBlock();    break;
+        default:       integrator->StepEuler();    break;
+    }
+}
+
+/**
+ * @brief Puts the bodies moved this step that have been resting long enough
+ *        to sleep. Called after collisions have pushed the bodies apart
+ *
+ * @return void
+ */
+void Integrator::Settle() {
+    if (!integrator->allowSleeping) return;
+
+    const float dt = float(Engine::GetDt());
+    integrator->ForAwake([dt](unsigned i) { integrator->Rest(i, dt); });
+}
+
+/**
+ * @brief Returns the method being used
+ *
+ * @return Integrator::Method
+ */
+Integrator::Method Integrator::GetMethod() { return integrator->method; }
+
+/**
+ * @brief Sets the method used from the next step on. Bodies start new blocks
+ *        when the block method is picked again
+ *
+ * @param method_
+ * @return void
+ */
+void Integrator::SetMethod(Method method_) {
+    if (method_ < 0 || method_ >= MethodCount) return;
+    if (method_ != integrator->method) {
+        Physics_Data& physics = Component_Storage::GetPhysicsData();
+        std::fill(physics.blockLevel.begin(), physics.blockLevel.end(), Physics_Data::noBlock);
+        std::fill(physics.hasEndGravity.begin(), physics.hasEndGravity.end(), 0);
+    }
+    integrator->method = method_;
+}
+
+/**
+ * @brief Returns reference to whether resting bodies are put to sleep
+ *
+ * @return bool&
+ */
+bool& Integrator::GetAllowSleeping() { return integrator->allowSleeping; }
+
+/**
+ * @brief Returns the number of sleeping bodies found at the start of the last step
+ *
+ * @return unsigned
+ */
+unsigned Integrator::GetSleepingCount() { return integrator->sleepingCount; }
+
+/**
+ * @brief Returns the number of bodies whose pull was found in the last step
+ *        (block and Verlet methods)
+ *
+ * @return unsigned
+ */
+unsigned Integrator::GetPullCount() { return integrator->pullCount; }
+
+/**
+ * @brief Semi-implicit Euler: v += a(x) dt, then x += v dt
+ *
+ */
+void Integrator::StepEuler() {
+    const Real dt = Engine::GetDt();
+
+    if (needsGravity) Gravity::Compute(Component_Storage::GetTransformData().position.data());
+
+    ForAwake([this, dt](unsigned i) {
+        Physics_Data& physics = Component_Storage::GetPhysicsData();
+        Transform_Data& transforms = Component_Storage::GetTransformData();
+        Prepare(physics, i);
+        Vec3 acceleration = GetAcceleration(i);
+        physics.velocity[i] += acceleration * dt;
+        physics.acceleration[i] = acceleration;
+        physics.usesGravity[i] = 0;
+        MoveTransform(transforms, physics, i, transforms.position[i] + physics.velocity[i] * dt, dt);
+    });
+}
+
+/**
+ * @brief Drift-kick-drift leapfrog: half a drift, a full kick using the forces
+ *        at the half way point, then the other half of the drift
+ *
+ */
+void Integrator::StepLeapfrog() {
+    stagePosition.resize(Component_Storage::GetEntityCount());
+    const Real dt = Engine::GetDt();
+
+      // Half drift
+    ForAwake([this, dt](unsigned i) {
+        Physics_Data& physics = Component_Storage::GetPhysicsData();
+        Prepare(physics, i);
+        stagePosition[i] = Component_Storage::GetTransformData().position[i] + physics.velocity[i] * (Real(0.5) * dt);
+    });
+
+    if (needsGravity) Gravity::Compute(stagePosition.data());
+
+      // Kick, then the second half drift
+    ForAwake([this, dt](unsigned i) {
+        Physics_Data& physics = Component_Storage::GetPhysicsData();
+        Vec3 acceleration = GetAcceleration(i);
+        physics.velocity[i] += acceleration * dt;
+        physics.acceleration[i] = acceleration;
+        physics.usesGravity[i] = 0;
+        MoveTransform(Component_Storage::GetTransformData(), physics, i, stagePosition[i] + physics.velocity[i] * (Real(0.5) * dt), dt);
+    });
+}
+
+/**
+ * @brief Velocity Verlet: half a kick, a full drift, then half a kick using the
+ *        forces at the new positions. Velocities line up with the positions at
+ *        the end of the step. The pull found for the closing kick is kept and
+ *        opens the next step, so only one gravity pass is needed per step
+ *        unless bodies were woken, or added, removed, moved or weighed again
+ *        outside the Integrator (collisions, scripts or the editor)
+ *
+ */
+void Integrator::StepVerlet() {
+    Physics_Data& physics = Component_Storage::GetPhysicsData();
+    Transform_Data& transforms = Component_Storage::GetTransformData();
+    const Real dt = Engine::GetDt();
+
+    ForAwake([](unsigned i) { Prepare(Component_Storage::GetPhysicsData(), i); });
+
+      // Every kept pull is stale once any body was moved, weighed again, added
+      // or removed outside the Integrator, or the gravitational constant changed
+    if (Gravity::GetGeneration() != endGravityGeneration || Engine::GetGravConst() != endGravityConst)
+        std::fill(physics.hasEndGravity.begin(), physics.hasEndGravity.end(), 0);
+
+      // Pull for the opening kick, only found for the bodies without a kept
+      // pull (just woken or just asking for gravity)
+    pullCount = 0;
+    if (needsGravity) {
+        unsigned pulled = 0;
+        due.clear();
+        for (unsigned i : awake) {
+            if (!physics.usesGravity[i]) continue;
+            ++pulled;
+            if (!physics.hasEndGravity[i]) due.emplace_back(i);
+        }
+
+        if (!due.empty() && due.size() == pulled) {
+            Gravity::Compute(transforms.position.data());
+            pullCount = bodyCount;
+        }
+        else if (!due.empty()) {
+            Gravity::Compute(transforms.position.data(), due);
+            pullCount = due.size();
+        }
+        for (unsigned i : due) physics.endGravity[i] = Gravity::GetAcceleration(i);
+    }
+
+      // Half kick and drift
+    ForAwake([this, dt](unsigned i) {
+        Physics_Data& physics = Component_Storage::GetPhysicsData();
+        Transform_Data& transforms = Component_Storage::GetTransformData();
+        Vec3 acceleration = physics.acceleration[i];
+        if (needsGravity && physics.usesGravity[i]) acceleration += physics.endGravity[i];
+        physics.velocity[i] += acceleration * (Real(0.5) * dt);
+        MoveTransform(transforms, physics, i, transforms.position[i] + physics.velocity[i] * dt, dt);
+    });
+
+    if (needsGravity) {
+        Gravity::Compute(transforms.position.data());
+        pullCount += bodyCount;
+        endGravityGeneration = Gravity::GetGeneration();
+        endGravityConst = Engine::GetGravConst();
+    }
+
+      // Second half kick, keeping the pull for the next step
+    ForAwake([this, dt](unsigned i) {
+        Physics_Data& physics = Component_Storage::GetPhysicsData();
+        Vec3 acceleration = GetAcceleration(i);
+        physics.velocity[i] += acceleration * (Real(0.5) * dt);
+        physics.acceleration[i] = acceleration;
+        physics.hasEndGravity[i] = needsGravity && physics.usesGravity[i];
+        if (physics.hasEndGravity[i]) physics.endGravity[i] = Gravity::GetAcceleration(i);
+        physics.usesGravity[i] = 0;
+    });
+}
+
+/**
+ * @brief Classic Runge-Kutta 4. Each of the four stages finds the forces at a
+ *        trial position, and the step uses the weighted sum of the stages
+ *
+ */
+void Integrator::StepRK4() {
+    unsigned entityCount = Component_Storage::GetEntityCount();
+    stagePosition.resize(entityCount);
+    stageVelocity.resize(entityCount);
+    sumPosition.resize(entityCount);
+    sumVelocity.resize(entityCount);
+    const Real dt = Engine::GetDt();
+
+    ForAwake([this](unsigned i) {
+        Physics_Data& physics = Component_Storage::GetPhysicsData();
+        Prepare(physics, i);
+        stagePosition[i] = Component_Storage::GetTransformData().position[i];
+        stageVelocity[i] = physics.velocity[i];
+        sumPosition[i] = Vec3(0);
+        sumVelocity[i] = Vec3(0);
+    });
+
+      // Weight of each stage in the sum, and how far into the step the next
+      // stage looks
+    const Real weights[4] = { 1, 2, 2, 1 };
+    const Real nextStage[4] = { 0.5, 0.5, 1, 0 };
+
+    for (unsigned stage = 0; stage < 4; ++stage) {
+        if (needsGravity) Gravity::Compute(stagePosition.data());
+
+        const Real weight = weights[stage];
+        const Real next = nextStage[stage] * dt;
+        ForAwake([this, weight, next](unsigned i) {
+            const Physics_Data& physics = Component_Storage::GetPhysicsData();
+            Vec3 acceleration = GetAcceleration(i);
+            sumPosition[i] += stageVelocity[i] * weight;
+            sumVelocity[i] += acceleration * weight;
+
+              // Trial position uses this stage's velocity, so it's set first
+            stagePosition[i] = Component_Storage::GetTransformData().position[i] + stageVelocity[i] * next;
+            stageVelocity[i] = physics.velocity[i] + acceleration * next;
+        });
+    }
+
+    ForAwake([this, dt](unsigned i) {
+        Physics_Data& physics = Component_Storage::GetPhysicsData();
+        Transform_Data& transforms = Component_Storage::GetTransformData();
+        physics.velocity[i] += sumVelocity[i] * (dt / Real(6));
+        physics.acceleration[i] = sumVelocity[i] / Real(6);
+        physics.usesGravity[i] = 0;
+        MoveTransform(transforms, physics, i, transforms.position[i] + sumPosition[i] * (dt / Real(6)), dt);
+    });
+}
+
+/**
+ * @brief Block timesteps: drift-kick-drift leapfrog where each body kicks with
+ *        its own step, dt times a power of two chosen from its velocity and
+ *        acceleration. Every body drifts each step, but only the bodies whose
+ *        block ends have their pull found, so slow bodies cost far fewer force
+ *        passes. Forces added by scripts are still applied every step
+ *
+ */
+void Integrator::StepBlock() {
+    Physics_Data& physics = Component_Storage::GetPhysicsData();
+    Transform_Data& transforms = Component_Storage::GetTransformData();
+    const Real dt = Engine::GetDt();
+
+    ForAwake([](unsigned i) { Prepare(Component_Storage::GetPhysicsData(), i); });
+
+      // Bodies that just asked for gravity (new, woken or switched on) need
+      // their pull before their first block opens
+    due.clear();
+    for (unsigned i : awake) {
+        if (physics.usesGravity[i] && physics.blockLevel[i] == Physics_Data::noBlock) due.emplace_back(i);
+    }
+    pullCount = due.size();
+    if (!due.empty()) {
+        Gravity::Compute(transforms.position.data(), due);
+        for (unsigned i : due) {
+            physics.blockGravity[i] = Gravity::GetAcceleration(i);
+            physics.blockLevel[i] = ChooseLevel(i);
+        }
+    }
+
+      // Opening half kick of the blocks starting now, the kick of the forces
+      // held for this step, then the drift
+    ForAwake([this, dt](unsigned i) {
+        Physics_Data& physics = Component_Storage::GetPhysicsData();
+        Transform_Data& transforms = Component_Storage::GetTransformData();
+        unsigned char level = physics.blockLevel[i];
+        if (level != Physics_Data::noBlock && blockTick % (1u << level) == 0) {
+            if (physics.usesGravity[i])
+                physics.velocity[i] += physics.blockGravity[i] * (Real(0.5) * dt * Real(1u << level));
+            else
+                physics.blockLevel[i] = Physics_Data::noBlock;
+        }
+        physics.velocity[i] += physics.acceleration[i] * dt;
+        MoveTransform(transforms, physics, i, transforms.position[i] + physics.velocity[i] * dt, dt);
+    });
+
+      // Closing half kick of the blocks ending now, found with every body
+      // drifted to the end of the step
+    ++blockTick;
+    due.clear();
+    for (unsigned i : awake) {
+        unsigned char level = physics.blockLevel[i];
+        if (level != Physics_Data::noBlock && blockTick % (1u << level) == 0) due.emplace_back(i);
+    }
+    pullCount += due.size();
+    if (!due.empty()) {
+        Gravity::Compute(transforms.position.data(), due);
+        Job_System::ParallelFor(due.size(), 1024, [this, dt](unsigned begin, unsigned end) {
+            Physics_Data& physics = Component_Storage::GetPhysicsData();
+            for (unsigned k = begin; k < end; ++k) {
+                unsigned i = due[k];
+                Vec3 pull = Gravity::GetAcceleration(i);
+                physics.velocity[i] += pull * (Real(0.5) * dt * Real(1u << physics.blockLevel[i]));
+                physics.blockGravity[i] = pull;
+                physics.blockLevel[i] = ChooseLevel(i);
+            }
+        });
+    }
+
+    ForAwake([](unsigned i) {
+        Physics_Data& physics = Component_Storage::GetPhysicsData();
+        if (physics.blockLevel[i] != Physics_Data::noBlock) physics.acceleration[i] += physics.blockGravity[i];
+        physics.usesGravity[i] = 0;
+    });
+}
+
+/**
+ * @brief Finds the bodies that move this step. Sleeping bodies are woken by
+ *        forces other than the ones they fell asleep under, a velocity given
+ *        to them (scripts or editor), or gravity, the rest stay out of the
+ *        list (collisions wake the bodies they push). Objects without a
+ *        Transform have nothing to move, so only their velocity is updated here
+ *
+ * @param entityCount
+ */
+void Integrator::FindAwake(unsigned entityCount) {
+    Physics_Data& physics = Component_Storage::GetPhysicsData();
+    const Transform_Data& transforms = Component_Storage::GetTransformData();
+    const Real dt = Engine::GetDt();
+    const bool gravityPulls = Engine::GetGravConst() != 0.0;
+    const Real limit = Real(sleepVelocity) * Real(sleepVelocity);
+
+    awake.clear();
+    needsGravity = false;
+    sleepingCount = 0;
+    bodyCount = 0;
+    Component_Storage::ForEach<Physics>(0, entityCount, [&](unsigned i, Physics&) {
+        if (transforms.isUsed[i]) ++bodyCount;
+        if (physics.isSleeping[i]) {
+              // A steady force (a uniform field or a script pushing the same
+              // way every step) doesn't keep a body from sleeping
+            Vec3 change = (physics.forces[i] - physics.heldForces[i]) / physics.mass[i];
+            bool isDisturbed = glm::dot(change, change) >= limit || physics.velocity[i] != Vec3(0) ||
+                physics.rotationalVelocity[i] != glm::vec3(0.f) || (gravityPulls && physics.usesGravity[i]);
+            if (!isDisturbed) {
+                physics.forces[i] = Vec3(0);
+                physics.usesGravity[i] = 0;
+                ++sleepingCount;
+                return;
+            }
+            physics.isSleeping[i] = 0;
+            physics.restTime[i] = 0.f;
+            physics.hasEndGravity[i] = 0;
+        }
+
+        if (!transforms.isUsed[i]) {
+            Prepare(physics, i);
+            physics.velocity[i] += physics.acceleration[i] * dt;
+            physics.usesGravity[i] = 0;
+            return;
+        }
+
+        if (physics.usesGravity[i]) needsGravity = true;
+        awake.emplace_back(i);
+    });
+}
+
+/**
+ * @brief Puts the body to sleep once it has been slow and barely moved for
+ *        sleepDelay seconds (checked after collisions, so a body held up by
+ *        another one under a steady force counts as resting). Its velocities
+ *        are zeroed so anything that moves it wakes it
+ *
+ * @param entity
+ * @param dt
+ */
+void Integrator::Rest(unsigned entity, float dt) const {
+    Physics_Data& physics = Component_Storage::GetPhysicsData();
+    Transform_Data& transforms = Component_Storage::GetTransformData();
+    const float limit = sleepVelocity * sleepVelocity;
+    Vec3 moved = transforms.position[entity] - transforms.oldPosition[entity];
+    bool isResting = glm::dot(physics.velocity[entity], physics.velocity[entity]) < limit &&
+        glm::dot(physics.rotationalVelocity[entity], physics.rotationalVelocity[entity]) < limit &&
+        glm::dot(moved, moved) < limit * dt * dt;
+    if (!isResting) {
+        physics.restTime[entity] = 0.f;
+        return;
+    }
+
+    physics.restTime[entity] += dt;
+    if (physics.restTime[entity] < sleepDelay) return;
+
+      // Drawn where it stopped from now on
+    physics.velocity[entity] = Vec3(0);
+    physics.rotationalVelocity[entity] = glm::vec3(0.f);
+    physics.acceleration[entity] = Vec3(0);
+    physics.isSleeping[entity] = 1;
+    physics.blockLevel[entity] = Physics_Data::noBlock;
+    physics.hasEndGravity[entity] = 0;
+    transforms.oldPosition[entity] = transforms.position[entity];
+    transforms.oldRotation[entity] = transforms.rotation[entity];
+}
+
+/**
+ * @brief Returns the acceleration of the entity from its forces plus the pull
+ *        of the other bodies (if it asked for it) at the last computed positions
+ *
+ * @param entity
+ * @return Vec3
+ */
+Vec3 Integrator::GetAcceleration(unsigned entity) const {
+    const Physics_Data& physics = Component_Storage::GetPhysicsData();
+    Vec3 acceleration = physics.acceleration[entity];
+    if (needsGravity && physics.usesGravity[entity]) acceleration += Gravity::GetAcceleration(entity);
+    return acceleration;
+}
+
+/**
+ * @brief Picks the block level of a body starting a block: the longest block
+ *        (up to maxBlockLevel) no longer than blockAccuracy times the time its
+ *        acceleration takes to change its velocity by its own size. Blocks
+ *        start on a multiple of their own length, so a body can only move up
+ *        a level where the longer block lines up
+ *
+ * @param entity
+ * @return unsigned char
+ */
+unsigned char Integrator::ChooseLevel(unsigned entity) const {
+    const Physics_Data& physics = Component_Storage::GetPhysicsData();
+    const Real dt = Engine::GetDt();
+    Vec3 acceleration = physics.acceleration[entity] + physics.blockGravity[entity];
+    Real accelerationSq = glm::dot(acceleration, acceleration);
+
+    unsigned level = maxBlockLevel;
+    if (accelerationSq > Real(0)) {
+        const Real velocitySq = glm::dot(physics.velocity[entity], physics.velocity[entity]);
+        const Real step = Real(blockAccuracy) * std::sqrt(velocitySq / accelerationSq);
+        level = 0;
+        while (level < maxBlockLevel && dt * Real(2u << level) <= step) ++level;
+    }
+
+    while (level > 0 && blockTick % (1u << level) != 0) --level;
+    return (unsigned char)level;
+}
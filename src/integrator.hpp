@@ -0,0 +1,102 @@
+/**
+ * @file integrator.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-13
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef INTEGRATOR_HPP
+#define INTEGRATOR_HPP
+
+// std includes //
+#include <vector>
+
+// Library includes //
+#include <vec3.hpp>
+
+// Engine includes //
+#include "component_storage.hpp"
+#include "file_reader.hpp"
+#include "file_writer.hpp"
+#include "job_system.hpp"
+
+/*! Integrator class (moves every body forward one fixed step) */
+class Integrator {
+    public:
+        /*! Way the bodies are moved each step */
+        enum Method {
+            Euler,    //!< Semi-implicit Euler (1st order, one gravity pass)
+            Leapfrog, //!< Drift-kick-drift leapfrog (2nd order symplectic, one gravity pass)
+            Verlet,   //!< Velocity Verlet (2nd order symplectic, two gravity passes)
+            RK4,      //!< Runge-Kutta 4 (4th order, not symplectic, four gravity passes)
+            Block,    //!< Leapfrog with a power of two step per body, gravity only for the bodies due
+            MethodCount
+        };
+
+        static const char* methodNames[MethodCount]; //!< Name of each method (used in presets)
+
+        static bool Initialize(File_Reader& preset);
+        static bool Initialize();
+        static void Shutdown();
+        static void Write(File_Writer& writer);
+
+        static void Step();
+        static void Settle();
+
+        static Method GetMethod();
+        static void SetMethod(Method method_);
+        static bool& GetAllowSleeping();
+        static unsigned GetSleepingCount();
+        static unsigned GetPullCount();
+    private:
+        void StepEuler();
+        void StepLeapfrog();
+        void StepVerlet();
+        void StepRK4();
+        void StepBlock();
+
+        void FindAwake(unsigned entityCount);
+        void Rest(unsigned entity, float dt) const;
+        Vec3 GetAcceleration(unsigned entity) const;
+        unsigned char ChooseLevel(unsigned entity) const;
+
+        /**
+         * @brief Calls function(entity) for every awake body, spread over the
+         *        job system
+         *
+         * @param function
+         */
+        template <typename Function>
+        void ForAwake(Function function) const {
+            Job_System::ParallelFor(awake.size(), 1024, [this, &function](unsigned begin, unsigned end) {
+                for (unsigned k = begin; k < end; ++k) function(awake[k]);
+            });
+        }
+    private:
+        Aligned_Vector<Vec3> stagePosition; //!< Position the forces are found at in the current stage
+        Aligned_Vector<Vec3> stageVelocity; //!< Velocity of the current stage (RK4)
+        Aligned_Vector<Vec3> sumPosition;   //!< Weighted sum of the stage velocities (RK4)
+        Aligned_Vector<Vec3> sumVelocity;   //!< Weighted sum of the stage accelerations (RK4)
+        std::vector<unsigned> awake;        //!< Entities moved this step (awake, with a Transform)
+        std::vector<unsigned> due;          //!< Entities whose pull is found this step (block)
+        Method method;                      //!< Method being used
+        bool needsGravity;                  //!< Whether any object asked for gravity this step
+        bool allowSleeping;                 //!< Whether resting bodies are put to sleep
+        float sleepVelocity;                //!< Speed (and distance moved per second) below which a body is resting
+        float sleepDelay;                   //!< Seconds a body rests before it sleeps
+        unsigned sleepingCount;             //!< Sleeping bodies found at the start of the last step
+        unsigned maxBlockLevel;             //!< Longest block is dt times 2 to this
+        float blockAccuracy;                //!< Fraction of |v| / |a| a body's block may last
+        unsigned blockTick;                 //!< Steps taken with blocks (blocks start on multiples of their length)
+        unsigned pullCount;                 //!< Bodies whose pull was found in the last step
+        unsigned bodyCount;                 //!< Bodies with a Transform at the start of the step (awake or not)
+        unsigned endGravityGeneration;      //!< Gravity generation the kept pulls were found in (Verlet)
+        double endGravityConst;             //!< Gravitational constant the kept pulls were found with (Verlet)
+};
+
+#endif
@@ -0,0 +1,222 @@
+/**
+ * @file job_system.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-06
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// std includes //
+#include <algorithm>
+
+// Engine includes //
+#include "job_system.hpp"
+#include "trace.hpp"
+
+static Job_System* job_system = nullptr; //!< Job_System object
+static thread_local unsigned threadIndex = 0; //!< Index of the current thread (main thread is 0)
+
+/**
+ * @brief Initializes the job system with one thread per hardware thread (the
+ *        main thread counts as one of them)
+ *
+ * @return true
+ * @return false
+ */
+bool Job_System::Initialize() {
+      // Initializing job_system
+    job_system = new Job_System;
+    if (!job_system) {
+        Trace::Message("Job System was not initialized.\n");
+        return false;
+    }
+
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    job_system->pendingJobs = 0;
+    job_system->isRunning = true;
+
+      // Every thread gets a queue, workers are started after so they can steal from any of them
+    for (unsigned i = 0; i < threadCount; ++i) {
+        job_system->queues.emplace_back(new Queue);
+    }
+    for (unsigned i = 1; i < threadCount; ++i) {
+        job_system->workers.emplace_back(&Job_System::WorkerLoop, job_system, i);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Stops the worker threads and deletes the job system
+ *
+ * @return void
+ */
+void Job_System::Shutdown() {
+    if (!job_system) return;
+
+      // Waking up the workers so they can see they need to stop
+    {
+        std::lock_guard<std::mutex> lock(job_system->sleepLock);
+        job_system->isRunning = false;
+    }
+    job_system->sleepSignal.notify_all();
+
+    for (std::thread& worker : job_system->workers) {
+        worker.join();
+    }
+
+    for (Queue* queue : job_system->queues) {
+        delete queue;
+    }
+
+    delete job_system;
+    job_system = nullptr;
+}
+
+/**
+ * @brief Splits [0, count) into ranges of grainSize and runs the job on each of
+ *        them across all threads. Returns once every range is done, so it can be
+ *        used as a barrier between phases
+ *
+ * @param count Number of items
+ * @param grainSize Number of items given to a thread at a time
+ * @param job Function taking the start and end (exclusive) of a range
+ * @return void
+ */
+void Job_System::ParallelFor(unsigned count, unsigned grainSize, const std::function<void(unsigned, unsigned)>& job) {
+    if (count == 0) return;
+    if (grainSize == 0) grainSize = 1;
+    unsigned chunks = (count + grainSize - 1) / grainSize;
+
+      // Not worth splitting up
+    if (!job_system || job_system->workers.empty() || chunks == 1) {
+        job(0, count);
+        return;
+    }
+
+      // Spreading the ranges over every queue, idle threads steal the rest
+    std::atomic<unsigned> remaining(chunks);
+    unsigned thread = threadIndex;
+    for (unsigned chunk = 0; chunk < chunks; ++chunk) {
+        unsigned begin = chunk * grainSize;
+        unsigned end = std::min(count, begin + grainSize);
+        job_system->Push((thread + chunk) % job_system->queues.size(), [&job, &remaining, begin, end]() {
+            job(begin, end);
+            remaining.fetch_sub(1);
+        });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(job_system->sleepLock);
+    }
+    job_system->sleepSignal.notify_all();
+
+      // Helping out until every range is finished
+    while (remaining.load() > 0) {
+        if (!job_system->RunOne(thread)) std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Returns the number of threads that run jobs (workers and main thread)
+ *
+ * @return unsigned
+ */
+unsigned Job_System::GetThreadCount() {
+    if (!job_system) return 1;
+    return job_system->queues.size();
+}
+
+/**
+ * @brief Returns the index of the calling thread (main thread is 0)
+ *
+ * @return unsigned
+ */
+unsigned Job_System::GetThreadIndex() { return threadIndex; }
+
+/**
+ * @brief Adds a job to the back of a queue
+ *
+ * @param queue Index of the queue
+ * @param job
+ */
+void Job_System::Push(unsigned queue, Job job) {
+    std::lock_guard<std::mutex> lock(queues[queue]->lock);
+    queues[queue]->jobs.emplace_back(std::move(job));
+    ++pendingJobs;
+}
+
+/**
+ * @brief Takes the newest job from the thread's own queue
+ *
+ * @param queue Index of the queue
+ * @param job Job that was taken
+ * @return true
+ * @return false
+ */
+bool Job_System::Pop(unsigned queue, Job& job) {
+    std::lock_guard<std::mutex> lock(queues[queue]->lock);
+    if (queues[queue]->jobs.empty()) return false;
+
+    job = std::move(queues[queue]->jobs.back());
+    queues[queue]->jobs.pop_back();
+    --pendingJobs;
+    return true;
+}
+
+/**
+ * @brief Takes the oldest job from another thread's queue
+ *
+ * @param thief Index of the thread stealing
+ * @param job Job that was taken
+ * @return true
+ * @return false
+ */
+bool Job_System::Steal(unsigned thief, Job& job) {
+    for (unsigned offset = 1; offset < queues.size(); ++offset) {
+        Queue* victim = queues[(thief + offset) % queues.size()];
+        std::unique_lock<std::mutex> lock(victim->lock, std::try_to_lock);
+        if (!lock.owns_lock() || victim->jobs.empty()) continue;
+
+        job = std::move(victim->jobs.front());
+        victim->jobs.pop_front();
+        --pendingJobs;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Runs one job from the thread's queue, or stolen from another
+ *
+ * @param thread Index of the thread
+ * @return true A job was run
+ * @return false No job was found
+ */
+bool Job_System::RunOne(unsigned thread) {
+    Job job;
+    if (!Pop(thread, job) && !Steal(thread, job)) return false;
+
+    job();
+    return true;
+}
+
+/**
+ * @brief Loop run by each worker thread. Sleeps while there is nothing to do
+ *
+ * @param thread Index of the thread
+ */
+void Job_System::WorkerLoop(unsigned thread) {
+    threadIndex = thread;
+
+    while (isRunning) {
+        if (RunOne(thread)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepLock);
+        sleepSignal.wait(lock, [this]() { return pendingJobs.load() > 0 || !isRunning.load(); });
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file job_system.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-06
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+// std includes //
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*! Job_System class */
+class Job_System {
+    public:
+        static bool Initialize();
+        static void Shutdown();
+
+        static void ParallelFor(unsigned count, unsigned grainSize, const std::function<void(unsigned, unsigned)>& job);
+
+        static unsigned GetThreadCount();
+        static unsigned GetThreadIndex();
+    private:
+        typedef std::function<void()> Job; //!< Work to be done by any thread
+
+        /*! Queue of jobs owned by one thread (others steal from the front) */
+        struct Queue {
+            std::deque<Job> jobs; //!< Jobs waiting to be run
+            std::mutex lock;      //!< Guards jobs
+        };
+
+        void Push(unsigned queue, Job job);
+        bool Pop(unsigned queue, Job& job);
+        bool Steal(unsigned thief, Job& job);
+        bool RunOne(unsigned thread);
+        void WorkerLoop(unsigned thread);
+    private:
+        std::vector<Queue*> queues;          //!< One queue per thread (main thread is 0)
+        std::vector<std::thread> workers;    //!< Worker threads
+        std::atomic<int> pendingJobs;        //!< Jobs pushed but not yet taken
+        std::atomic<bool> isRunning;         //!< Whether workers should keep running
+        std::mutex sleepLock;                //!< Used by idle workers to wait for jobs
+        std::condition_variable sleepSignal; //!< Wakes idle workers when jobs are pushed
+};
+
+#endif
@@ -9,19 +9,86 @@
  * 
  */
 
+// std includes //
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
 // Engine includes //
 #include "trace.hpp"
 #include "engine.hpp"
 #include "graphics.hpp"
 
+/**
+ * @brief Prints how to run the engine from the command line
+ * 
+ * @return void
+ */
+static void PrintUsage() {
+    std::cout << "usage: pEngine [--data folder]\n"
+              << "       pEngine --headless preset [--steps count] [--seconds time] [--dump file] [--data folder]\n"
+              << "  --headless  runs the preset without a window and reports steps per second\n"
+              << "  --steps     steps to run (default 1000 when --seconds isn't given)\n"
+              << "  --seconds   real time to run for\n"
+              << "  --dump      writes the final position, velocity and mass of every object to file\n"
+              << "  --data      folder the json, models, scripts, etc. are read from\n";
+}
+
 /**
  * @brief Main function
  * 
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
  * @return int 
  */
-int main (int, char *[]) {
+int main (int argc, char *argv[]) {
+    std::string preset;
+    std::string dumpFile;
+    unsigned steps = 0;
+    float seconds = 0.f;
+    bool isHeadless = false;
+
+      // Reading command line arguments
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--headless") == 0 && hasValue) {
+            isHeadless = true;
+            preset = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--steps") == 0 && hasValue) steps = unsigned(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue) seconds = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--dump") == 0 && hasValue) dumpFile = argv[++i];
+        else if (std::strcmp(argv[i], "--data") == 0 && hasValue) Engine::SetDataPath(argv[++i]);
+        else {
+            PrintUsage();
+            return -1;
+        }
+    }
+
       // Initializing systems
     Trace::Initialize();
+
+    if (isHeadless) {
+        if (steps == 0 && seconds <= 0.f) steps = 1000;
+
+        if (!Engine::InitializeHeadless(preset)) {
+            Engine::Shutdown();
+            Trace::Shutdown();
+            return -1;
+        }
+          // Simulation loop (no window)
+        Engine::RunHeadless(steps, seconds);
+        int result = 0;
+        if (!dumpFile.empty() && !Engine::WriteState(dumpFile)) result = -1;
+
+          // Shutting down systems
+        Engine::Shutdown();
+        Trace::Shutdown();
+
+        return result;
+    }
+
     if (!Engine::Initialize()) return -1;
       // Engine update loop
     Graphics::Update();
@@ -31,4 +98,4 @@ int main (int, char *[]) {
     Trace::Shutdown();
 
     return 0;
-}
\ No newline at end of file
+}
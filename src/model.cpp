@@ -29,14 +29,15 @@
  * 
  * @param mode_ Draw mode for opengl
  */
-Model::Model(GLenum mode_) : Component(CType::CModel), mode(mode_), data(nullptr), texture(nullptr) {}
+Model::Model(GLenum mode_) : Component(GetCType()), mode(mode_), data(nullptr), texture(nullptr) {}
 
 /**
  * @brief Copy constructor
  * 
  * @param other 
  */
-Model::Model(const Model& other) : Component(CType::CModel) { *this = other; }
+Model::Model(const Model& other) : Component(GetCType()), mode(other.mode), data(other.data),
+    texture(other.texture) {}
 
 /**
  * @brief Creates a Model object using the data from a file
@@ -44,7 +45,7 @@ Model::Model(const Model& other) : Component(CType::CModel) { *this = other; }
  * @param reader File with Model data
  * @param mode_  Draw mode for opengl
  */
-Model::Model(File_Reader& reader, GLenum mode_) : Component(CType::CModel), mode(mode_), data(nullptr), texture(nullptr) {
+Model::Model(File_Reader& reader, GLenum mode_) : Component(GetCType()), mode(mode_), data(nullptr), texture(nullptr) {
     Read(reader);
 }
 
@@ -69,11 +70,11 @@ void Model::Load(File_Reader& reader) {
 /**
  * @brief Draw the model
  * 
+ * @param transform Transform of the model's object
  * @param projection Projection matrix of the scene
  * @param view View matrix of the scene
  */
-void Model::Draw(glm::mat4 projection, glm::mat4 view) {
-    Transform* transform = GetParent()->GetComponent<Transform>();
+void Model::Draw(Transform* transform, glm::mat4 projection, glm::mat4 view) {
     if (!data) return;
 
     data->Draw(this, transform, projection, view);
@@ -86,14 +87,25 @@ void Model::Draw(glm::mat4 projection, glm::mat4 view) {
  */
 void Model::Read(File_Reader& reader) { Load(reader); }
 
+/**
+ * @brief Uses the model and texture of another Model (the one kept by a
+ *        Prototype)
+ * 
+ * @param other 
+ */
+void Model::Read(const Model& other) {
+    data = other.data;
+    texture = other.texture;
+}
+
 /**
  * @brief Gives name of model and texture to writer
  * 
  * @param writer 
  */
 void Model::Write(File_Writer& writer) {
-    std::string modelName = data->GetModelName();
-    std::string textureName = texture->GetTextureName();
+    std::string modelName = GetModelName();
+    std::string textureName = GetTextureName();
 
     writer.Write_String("modelToLoad", modelName.c_str());
     writer.Write_String("textureToLoad", textureName.c_str());
@@ -148,13 +160,4 @@ std::string Model::GetTextureName() const {
  * 
  * @return Texture* 
  */
-Texture* Model::GetTexture() const { return texture; }
-
-/**
- * @brief Gets the CType of Model (used in Object::GetComponent<>())
- * 
- * @return CType 
- */
-CType Model::GetCType() {
-    return CType::CModel;
-}
\ No newline at end of file
+Texture* Model::GetTexture() const { return texture; }
\ No newline at end of file
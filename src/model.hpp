@@ -26,20 +26,22 @@
 #include "file_reader.hpp"
 #include "file_writer.hpp"
 #include "model_data.hpp"
+#include "pool.hpp"
 #include "texture.hpp"
 
 /*! Model class */
-class Model : public Component {
+class Model : public Component, public Pooled<Model> {
     public:
         Model(GLenum mode_ = GL_TRIANGLES);
         Model(const Model& other);
         Model(File_Reader& reader, GLenum mode_ = GL_TRIANGLES);
-        Model* Clone() const;
+        Model* Clone() const override;
 
         void Load(File_Reader& reader);
-        void Draw(glm::mat4 projection, glm::mat4 view);
+        void Draw(Transform* transform, glm::mat4 projection, glm::mat4 view);
 
         void Read(File_Reader& reader);
+        void Read(const Model& other);
         void Write(File_Writer& writer);
         
         void SwitchModel(std::string modelName);
@@ -50,7 +52,12 @@ class Model : public Component {
 
         Texture* GetTexture() const;
 
-        static CType GetCType();
+        /**
+         * @brief Gets the CType of Model (used in Object::GetComponent<>())
+         * 
+         * @return CType 
+         */
+        static constexpr CType GetCType() { return TypeOf<Model>(); }
     private:
         GLenum mode;      //!< Draw mode (Default is GL_TRIANGLES)
         Model_Data* data; //!< Data about the faces of the model
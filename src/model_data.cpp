@@ -94,7 +94,7 @@ bool Model_Data::Load(std::string modelName_) { return Read(modelName_); }
  */
 bool Model_Data::Read(std::string modelName_) {
       // Opening the file
-    std::string fileToOpen = std::string(getenv("USERPROFILE")) + "/Documents/pEngine/models/" + modelName_;
+    std::string fileToOpen = Engine::GetDataPath() + "models/" + modelName_;
       // Setting the name of the file (used in model_data_manager)
     modelName = fileToOpen;
     
@@ -222,13 +222,9 @@ bool Model_Data::Read(std::string modelName_) {
  * @param view View matrix of the scene
  */
 void Model_Data::Draw(Model* parent, Transform* transform, glm::mat4 projection, glm::mat4 view) {
-      // Creating the MVP (Model * View * Projection) matrix
-    glm::mat4 model = glm::mat4(1.f);
-    model = glm::translate(model, transform->GetPosition());
-    model = glm::rotate(model, (transform->GetRotation().x / 180.f) * glm::pi<float>(), glm::vec3(1, 0, 0));
-    model = glm::rotate(model, (transform->GetRotation().y / 180.f) * glm::pi<float>(), glm::vec3(0, 1, 0));
-    model = glm::rotate(model, (transform->GetRotation().z / 180.f) * glm::pi<float>(), glm::vec3(0, 0, 1));
-    model = glm::scale(model, transform->GetScale());
+      // Creating the MVP (Model * View * Projection) matrix (the model matrix
+      // is found by the Transform before drawing, see UpdateRenderMatrices)
+    glm::mat4 model = transform->GetRenderMatrix();
 
       // Sending data to the shaders
     glm::mat4 MVP = projection * view * model;
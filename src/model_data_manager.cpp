@@ -42,6 +42,9 @@ bool Model_Data_Manager::Initialize() {
  * @return Model_Data* Model data either read or gotten from list
  */
 Model_Data* Model_Data_Manager::Get(File_Reader& reader) {
+      // Nothing is loaded when running without graphics
+    if (!model_data_manager) return nullptr;
+
     std::string filename = reader.Read_String("modelToLoad");
       // Checks name of file against other model data objects
     for (Model_Data* model_data : model_data_manager->models) {
@@ -67,6 +70,9 @@ Model_Data* Model_Data_Manager::Get(File_Reader& reader) {
  * @return Model_Data* Model data either read or gotten from list
  */
 Model_Data* Model_Data_Manager::Get(std::string modelName) {
+      // Nothing is loaded when running without graphics
+    if (!model_data_manager) return nullptr;
+
       // Checks name of file against other model data objects
     for (Model_Data* model_data : model_data_manager->models) {
         if (model_data->GetModelName().compare(modelName) == 0) {
@@ -0,0 +1,260 @@
+/**
+ * @file neighbor_list.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// std includes //
+#include <algorithm>
+#include <numeric>
+
+// Library includes //
+#include <glm.hpp>
+
+// Engine includes //
+  // System //
+#include "job_system.hpp"
+#include "neighbor_list.hpp"
+  // Component //
+#include "component_storage.hpp"
+#include "physics.hpp"
+#include "transform.hpp"
+  // Misc //
+#include "trace.hpp"
+
+static Neighbor_List* neighbor_list = nullptr; //!< Neighbor_List object
+
+static const float defaultSkinRatio = 0.1f; //!< Skin used when the preset doesn't set one (fraction of the cutoff)
+
+/**
+ * @brief Returns the hash bucket of the cell (mask is the bucket count - 1)
+ *
+ */
+static inline unsigned Bucket(glm::ivec3 cell, unsigned mask) {
+    return ((unsigned(cell.x) * 73856093u) ^ (unsigned(cell.y) * 19349663u) ^ (unsigned(cell.z) * 83492791u)) & mask;
+}
+
+/**
+ * @brief Initializes the neighbor lists using the cutoff and skin of the
+ *        preset ("neighborCutoff", "neighborSkin")
+ *
+ * @param preset Preset being loaded
+ * @return true
+ * @return false
+ */
+bool Neighbor_List::Initialize(File_Reader& preset) {
+    if (!Initialize()) return false;
+
+    neighbor_list->cutoff = std::max(Real(preset.Read_Float("neighborCutoff")), Real(0));
+    neighbor_list->skin = Real(preset.Read_Float("neighborSkin"));
+    if (neighbor_list->skin <= Real(0)) neighbor_list->skin = neighbor_list->cutoff * Real(defaultSkinRatio);
+
+    return true;
+}
+
+/**
+ * @brief Initializes the neighbor lists turned off
+ *
+ * @return true
+ * @return false
+ */
+bool Neighbor_List::Initialize() {
+      // Initializing neighbor_list
+    neighbor_list = new Neighbor_List;
+    if (!neighbor_list) {
+        Trace::Message("Neighbor List was not initialized.\n");
+        return false;
+    }
+
+    neighbor_list->cutoff = Real(0);
+    neighbor_list->skin = Real(0);
+    neighbor_list->buildCount = 0;
+
+    return true;
+}
+
+/**
+ * @brief Builds the lists again if bodies were added or removed, or if any
+ *        body moved more than half the skin since the last build (two bodies
+ *        could then have closed the whole skin). Cheap otherwise, so it is
+ *        called by every stage that uses the lists
+ *
+ * @return void
+ */
+void Neighbor_List::Update() {
+    if (!neighbor_list || neighbor_list->cutoff <= Real(0)) return;
+
+    if (neighbor_list->NeedsBuild()) neighbor_list->Build();
+}
+
+/**
+ * @brief Deletes the neighbor_list object
+ *
+ * @return void
+ */
+void Neighbor_List::Shutdown() {
+    if (!neighbor_list) return;
+
+    delete neighbor_list;
+    neighbor_list = nullptr;
+}
+
+/**
+ * @brief Gives the cutoff and skin to the writer
+ *
+ * @param writer
+ * @return void
+ */
+void Neighbor_List::Write(File_Writer& writer) {
+    writer.Write_Value("neighborCutoff", float(neighbor_list->cutoff));
+    writer.Write_Value("neighborSkin", float(neighbor_list->skin));
+}
+
+/**
+ * @brief Returns whether the preset turned the lists on
+ *
+ * @return true
+ * @return false
+ */
+bool Neighbor_List::IsEnabled() { return neighbor_list && neighbor_list->cutoff > Real(0); }
+
+/**
+ * @brief Returns the neighbor entities of the entity from the last build,
+ *        every body within the cutoff plus the skin (both bodies of a pair
+ *        list each other). Safe to call from any thread between builds
+ *
+ * @param entity
+ * @param count Set to the number of neighbors
+ * @return const unsigned*
+ */
+const unsigned* Neighbor_List::GetNeighbors(unsigned entity, unsigned& count) {
+    count = 0;
+    if (!IsEnabled() || entity >= neighbor_list->bodies.size()) return nullptr;
+    int body = neighbor_list->bodies[entity];
+    if (body == -1) return nullptr;
+
+    count = neighbor_list->offsets[body + 1] - neighbor_list->offsets[body];
+    return neighbor_list->neighbors.data() + neighbor_list->offsets[body];
+}
+
+/**
+ * @brief Adds the entities within the cutoff of the entity right now to found
+ *
+ * @param entity
+ * @param found
+ * @return void
+ */
+void Neighbor_List::FindNearby(unsigned entity, std::vector<unsigned>& found) {
+    unsigned count;
+    const unsigned* row = GetNeighbors(entity, count);
+    if (count == 0) return;
+
+    const Transform_Data& transforms = Component_Storage::GetTransformData();
+    const Real cutoffSq = neighbor_list->cutoff * neighbor_list->cutoff;
+    for (unsigned k = 0; k < count; ++k) {
+        Vec3 offset = transforms.position[row[k]] - transforms.position[entity];
+        if (glm::dot(offset, offset) <= cutoffSq) found.emplace_back(row[k]);
+    }
+}
+
+/**
+ * @brief Returns the distance the lists cover
+ *
+ * @return Real
+ */
+Real Neighbor_List::GetCutoff() { return neighbor_list->cutoff; }
+
+/**
+ * @brief Returns the extra distance added to the cutoff when building
+ *
+ * @return Real
+ */
+Real Neighbor_List::GetSkin() { return neighbor_list->skin; }
+
+/**
+ * @brief Returns the number of times the lists were built
+ *
+ * @return unsigned
+ */
+unsigned Neighbor_List::GetBuildCount() { return neighbor_list->buildCount; }
+
+/**
+ * @brief Returns whether the lists have to be built again
+ *
+ * @return true
+ * @return false
+ */
+bool Neighbor_List::NeedsBuild() {
+    current.clear();
+    Component_Storage::ForEach<Physics, Transform>([this](unsigned i, Physics&, Transform&) {
+        current.emplace_back(i);
+    });
+    if (current != entities) return true;
+
+    const Transform_Data& transforms = Component_Storage::GetTransformData();
+    const Real limitSq = Real(0.25) * skin * skin;
+    for (unsigned body = 0; body < entities.size(); ++body) {
+        Vec3 moved = transforms.position[entities[body]] - positions[body];
+        if (glm::dot(moved, moved) > limitSq) return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Builds every list from a hashed grid of cells as big as the cutoff
+ *        plus the skin. Each body's neighbors are counted first, so they can
+ *        be written straight into one array (compressed sparse rows)
+ *
+ */
+void Neighbor_List::Build() {
+    entities.swap(current);
+    unsigned count = entities.size();
+    const Transform_Data& transforms = Component_Storage::GetTransformData();
+
+    positions.resize(count);
+    bodies.assign(Component_Storage::GetEntityCount(), -1);
+    for (unsigned body = 0; body < count; ++body) {
+        positions[body] = transforms.position[entities[body]];
+        bodies[entities[body]] = int(body);
+    }
+
+    const Real reach = cutoff + skin;
+    const Real reachSq = reach * reach;
+    grid.Build(positions, reach);
+
+      // Calls function(b) for every body b within reach of body a
+    auto forEachNear = [this, reachSq](unsigned a, auto&& function) {
+        grid.ForEachNear(a, [this, a, reachSq, &function](unsigned b) {
+            Vec3 offset = positions[b] - positions[a];
+            if (glm::dot(offset, offset) <= reachSq) function(b);
+        });
+    };
+
+      // Counting each body's neighbors, then turning the counts into row starts
+    offsets.assign(count + 1, 0);
+    Job_System::ParallelFor(count, 256, [this, &forEachNear](unsigned begin, unsigned end) {
+        for (unsigned a = begin; a < end; ++a) {
+            unsigned found = 0;
+            forEachNear(a, [&found](unsigned) { ++found; });
+            offsets[a + 1] = found;
+        }
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+      // Each body writes only its own row
+    neighbors.resize(offsets[count]);
+    Job_System::ParallelFor(count, 256, [this, &forEachNear](unsigned begin, unsigned end) {
+        for (unsigned a = begin; a < end; ++a) {
+            unsigned next = offsets[a];
+            forEachNear(a, [this, &next](unsigned b) { neighbors[next++] = entities[b]; });
+        }
+    });
+
+    ++buildCount;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file neighbor_list.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-18
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef NEIGHBOR_LIST_HPP
+#define NEIGHBOR_LIST_HPP
+
+// std includes //
+#include <vector>
+
+// Engine includes //
+#include "file_reader.hpp"
+#include "file_writer.hpp"
+#include "hash_grid.hpp"
+#include "precision.hpp"
+
+/*! Neighbor_List class (bodies within the cutoff plus a skin of each body, kept
+    across steps until some body moves more than half the skin) */
+class Neighbor_List {
+    public:
+        static bool Initialize(File_Reader& preset);
+        static bool Initialize();
+        static void Update();
+        static void Shutdown();
+        static void Write(File_Writer& writer);
+
+        static bool IsEnabled();
+        static const unsigned* GetNeighbors(unsigned entity, unsigned& count);
+        static void FindNearby(unsigned entity, std::vector<unsigned>& found);
+        static Real GetCutoff();
+        static Real GetSkin();
+        static unsigned GetBuildCount();
+    private:
+        bool NeedsBuild();
+        void Build();
+    private:
+        std::vector<unsigned> entities;     //!< Entity of each body at the last build
+        std::vector<unsigned> current;      //!< Entity of each body now (checked against entities)
+        std::vector<int> bodies;            //!< Body of each entity at the last build (-1 if it has none)
+        std::vector<Vec3> positions;        //!< Position of each body at the last build
+        std::vector<unsigned> offsets;      //!< First neighbor of each body (count + 1 entries, CSR)
+        std::vector<unsigned> neighbors;    //!< Neighbor entities of every body, one body after another
+        Hash_Grid grid;                     //!< Bodies hashed into cells as big as the cutoff plus the skin
+        Real cutoff;                        //!< Distance the lists have to cover (0 turns them off)
+        Real skin;                          //!< Extra distance that lets the lists last several steps
+        unsigned buildCount;                //!< Times the lists were built since the preset was loaded
+};
+
+#endif
@@ -14,55 +14,43 @@
 #include "object.hpp"
   // Component //
 #include "behavior.hpp"
+#include "component_storage.hpp"
 #include "model.hpp"
 #include "object_manager.hpp"
 #include "physics.hpp"
 #include "transform.hpp"
   // Misc //
-#include "file_reader.hpp"
+#include "prototype_manager.hpp"
 
 /**
  * @brief Default constructor
  * 
  */
-Object::Object() : id(-1) {}
+Object::Object() : id(-1), entity(Component_Storage::CreateEntity()) { components.fill(nullptr); }
 
 /**
- * @brief Copy constructor
+ * @brief Copy constructor. The scripts of the copy start at its first update
  * 
  * @param other Object to be copied
  */
-Object::Object(const Object& other) {
+Object::Object(const Object& other) : id(-1), entity(Component_Storage::CreateEntity()) {
+    components.fill(nullptr);
     SetName(other.GetName());
-    SetTemplateName(other.GetTemplateName());
+    prototype = other.prototype;
 
-      // Copying Behavior component
-    Behavior* behavior = other.GetComponentConst<Behavior>();
-    if (behavior) {
-        Behavior* newBehavior = new Behavior(*behavior);
-        AddComponent(newBehavior);
-    }
-
-      // Copying Model component
-    Model* model = other.GetComponentConst<Model>();
-    if (model) {
-        Model* newModel = new Model(*model);
-        AddComponent(newModel);
-    }
-
-      // Copying Physics component
-    Physics* physics = other.GetComponentConst<Physics>();
-    if (physics) {
-        Physics* newPhysics = new Physics(*physics);
-        AddComponent(newPhysics);
+      // Copying every component the other object has
+    for (Component* component : other.components) {
+        if (component) AddComponent(component->Clone());
     }
+}
 
-      // Copying transform component
-    Transform* transform = other.GetComponentConst<Transform>();
-    if (transform) {
-        Transform* newTransform = new Transform(*transform);
-        AddComponent(newTransform);
-    }
+/**
+ * @brief Deletes the components of the object and gives back its entity
+ * 
+ */
+Object::~Object() {
+    Clear();
+    Component_Storage::ReleaseEntity(entity);
 }
 
 /**
@@ -75,28 +63,51 @@ Object* Object::Clone() const {
 }
 
 /**
- * @brief Updates object (only physics for now)
+ * @brief Adds component to object. Only one of each type of component
  * 
+ * @param component Component to be added
  */
-void Object::Update() {
-    Behavior* behavior = GetComponent<Behavior>();
-    if (behavior)
-        behavior->Update();
-    Physics* physics = GetComponent<Physics>();
-    if (physics)
-        physics->Update();
+void Object::AddComponent(Component* component) {
+    if (components[component->GetCType()]) return;
+
+    component->SetParent(this);
+    components[component->GetCType()] = component;
 }
 
 /**
- * @brief Adds component to object. Only one of each type of component
+ * @brief Stores every component in Component_Storage so the systems find it.
+ *        Called by Object_Manager::AddObject, the components of objects that
+ *        aren't added yet (queued in the Command_Buffer, prototypes) are left
+ *        out of every step
  * 
- * @param component Component to be added
  */
-void Object::AddComponent(Component* component) {
-    component->SetParent(this);
-    components.emplace(component->GetCType(), component);
+void Object::StoreComponents() {
+    for (Component* component : components) {
+        if (component) Component_Storage::SetComponent(component->GetCType(), entity, component);
+    }
+}
+
+/**
+ * @brief Removes the component of the given type from the object
+ * 
+ * @param type Type of component
+ */
+void Object::RemoveComponent(CType type) {
+    if (!components[type]) return;
+      // Delete component
+    delete components[type];
+    components[type] = nullptr;
 }
 
+/**
+ * @brief Checks if the object has a component of the given type
+ * 
+ * @param type Type of component
+ * @return true
+ * @return false
+ */
+bool Object::HasComponent(CType type) const { return components[type] != nullptr; }
+
 /**
  * @brief Sets the id of object
  * 
@@ -111,6 +122,14 @@ void Object::SetId(int id_) { id = id_; }
  */
 int Object::GetId() const { return id; }
 
+/**
+ * @brief Returns the entity of the object (index of its Transform and Physics
+ *        data in Component_Storage)
+ * 
+ * @return unsigned 
+ */
+unsigned Object::GetEntity() const { return entity; }
+
 /**
  * @brief Sets name of object
  * 
@@ -135,46 +154,45 @@ std::string Object::GetName() const { return name; }
 std::string& Object::GetNameRef() { return name; }
 
 /**
- * @brief Sets the name of the template file
+ * @brief Sets the template the object is made from. The template is shared
+ *        with every other object made from it
  * 
  * @param templateName_ Name of the template file
  */
-void Object::SetTemplateName(std::string templateName_) { templateName = templateName_; }
+void Object::SetTemplateName(std::string templateName_) { prototype = Prototype_Manager::Get(templateName_); }
 
 /**
  * @brief Returns the name of the template file
  * 
  * @return std::string 
  */
-std::string Object::GetTemplateName() const { return templateName; }
+std::string Object::GetTemplateName() const {
+    if (!prototype) return std::string("");
+    return prototype->GetTemplateName();
+}
 
 /**
- * @brief Reads object from file. This includes the components of an object
+ * @brief Makes object from its template. The template file is only read the
+ *        first time, after that the components of the shared prototype are
+ *        cloned
  * 
  * @param objectFilename
  * @return true
  * @return false
  */
 bool Object::Read(std::string objectFilename) {
-      // Getting data from file
-    File_Reader object_reader;
-    if (!object_reader.Read_File(objectFilename)) return false;
+      // Getting data from the prototype
+    prototype = Prototype_Manager::Get(objectFilename);
+    if (!prototype) return false;
 
-      // Reading Behavior component form file
-    Behavior* object_behavior = new Behavior(object_reader);
+      // Behavior shares the script list of the prototype
+    Behavior* object_behavior = new Behavior(prototype->GetScripts());
     AddComponent(object_behavior);
 
-      // Reading Model component from file
-    Model* object_model = new Model(object_reader);
-    AddComponent(object_model);
-    
-      // Reading Physics component from file
-    Physics* object_physics = new Physics(object_reader);
-    AddComponent(object_physics);
-    
-      // Reading Transform component from file
-    Transform* object_transform = new Transform(object_reader);
-    AddComponent(object_transform);
+      // Copying the components of the prototype
+    AddComponent(prototype->GetModel().Clone());
+    AddComponent(prototype->GetPhysics().Clone());
+    AddComponent(prototype->GetTransform().Clone());
 
     return true;
 }
@@ -187,47 +205,42 @@ bool Object::Read(std::string objectFilename) {
  * @return false
  */
 bool Object::ReRead(std::string objectFilename) {
-      // Getting data from file
-    File_Reader object_reader;
-    if (!object_reader.Read_File(objectFilename)) return false;
+      // Getting data from the prototype
+    std::shared_ptr<const Prototype> newPrototype = Prototype_Manager::Get(objectFilename);
+    if (!newPrototype) return false;
+    prototype = newPrototype;
 
     if (name.compare("") == 0)
-        SetName(object_reader.Read_String("name"));
-
-    templateName = objectFilename;
+        SetName(prototype->GetName());
 
-      // Reading Model component from file
+      // Reading Model component from the prototype
     Model* object_model = GetComponent<Model>();
     if (!object_model) {
         object_model = new Model;
         AddComponent(object_model); 
     }
-    object_model->Read(object_reader);
+    object_model->Read(prototype->GetModel());
     
-      // Reading Physics component from file
+      // Reading Physics component from the prototype
     Physics* object_physics = GetComponent<Physics>();
     if (!object_physics) {
         object_physics = new Physics;
         AddComponent(object_physics);
     }
-    object_physics->Read(object_reader);
+    object_physics->Read(prototype->GetPhysics());
     
-      // Reading Transform component from file
+      // Reading Transform component from the prototype
     Transform* object_transform = GetComponent<Transform>();
     if (!object_transform) {
         object_transform = new Transform;
         AddComponent(object_transform);
     }
-    object_transform->Read(object_reader);
+    object_transform->Read(prototype->GetTransform());
 
-      // Reading Behavior component form file
-    Behavior* object_behavior = GetComponent<Behavior>();
-    if (object_behavior) object_behavior->Clear();
-    if (!object_behavior) { 
-        object_behavior = new Behavior; 
-        AddComponent(object_behavior); 
-    }
-    object_behavior->Read(object_reader);
+      // Replacing Behavior component with one using the prototype's scripts
+    RemoveComponent(Behavior::GetCType());
+    Behavior* object_behavior = new Behavior(prototype->GetScripts());
+    AddComponent(object_behavior);
     object_behavior->SetupClassesForLua();
 
     return true;
@@ -241,7 +254,7 @@ bool Object::ReRead(std::string objectFilename) {
 void Object::Write(std::string filePath) {
     File_Writer object_writer;
     object_writer.Write_String("name", name);
-    templateName = filePath + "/" + name + ".json";
+    std::string templateName = filePath + "/" + name + ".json";
     Trace::Message(templateName + "\n");
 
     Model* object_model = GetComponent<Model>();
@@ -257,36 +270,29 @@ void Object::Write(std::string filePath) {
     if (object_behavior) object_behavior->Write(object_writer);
 
     object_writer.Write_File(templateName);
+
+      // Using the new template (read again in case an old version was kept)
+    Prototype_Manager::Forget(templateName);
+    prototype = Prototype_Manager::Get(templateName);
 }
 
 /**
- * @brief Returns the list of components
+ * @brief Returns the component of each type (nullptr for types the object
+ *        doesn't have)
  * 
- * @return std::unordered_map<CType, Component*> 
+ * @return const std::array<Component*, Component::typeCount>& 
  */
-std::unordered_map<CType, Component*> Object::GetComponentList() {
+const std::array<Component*, Component::typeCount>& Object::GetComponentList() const {
     return components;
 }
 
 /**
- * @brief Clears the components from the object
+ * @brief Deletes all of the components of the object
  * 
  */
 void Object::Clear() {
-    Behavior* behavior = GetComponent<Behavior>();
-    Model* model = GetComponent<Model>();
-    Physics* physics = GetComponent<Physics>();
-
-    if (behavior) {
-        delete behavior;
-        behavior = nullptr;
-    }
-    if (model) {
-        delete model;
-        model = nullptr;
+    for (Component*& component : components) {
+        delete component;
+        component = nullptr;
     }
-    if (physics) {
-        delete physics;
-        physics = nullptr;
-    }
-}
\ No newline at end of file
+}
@@ -14,22 +14,25 @@
 #define OBJECT_HPP
 
 // std includes //
-#include <unordered_map>
+#include <array>
+#include <memory>
 #include <string>
 
 // Engine includes //
 #include "component.hpp"
+#include "pool.hpp"
 #include "trace.hpp"
 
+class Prototype;
+
 /*! Object class */
-class Object {
+class Object : public Pooled<Object> {
     public:
         Object();
         Object(const Object& other);
+        ~Object();
 
         Object* Clone() const;
-    
-        void Update();
 
         void AddComponent(Component* component);
 
@@ -42,13 +45,8 @@ class Object {
          */
         template <typename T>
         T* GetComponent() {
-              // Searching for component using the type (enum as int)
-            auto found = components.find(T::GetCType());
-            if (found == components.end()) {
-                return nullptr;
-            }
-              // Cast found component into correct type
-            return (T*)found->second;
+              // The slot of the type is known at compile time
+            return static_cast<T*>(components[T::GetCType()]);
         }
 
         /**
@@ -57,20 +55,17 @@ class Object {
          * @tparam T 
          */
         template <typename T>
-        void RemoveComponent() {
-              // Searching for component using the type (enum as int)
-            auto found = components.find(T::GetCType());
-            if (found == components.end()) return;
-              // Delete component
-            delete found->second;
-            found->second = nullptr;
-              // Remove pointer from map
-            components.erase(found->first);
-        }
+        void RemoveComponent() { RemoveComponent(T::GetCType()); }
+
+        void RemoveComponent(CType type);
+        bool HasComponent(CType type) const;
+        void StoreComponents();
 
         void SetId(int id_);
         int GetId() const;
 
+        unsigned GetEntity() const;
+
         void SetName(std::string name_);
         std::string GetName() const;
         std::string& GetNameRef();
@@ -81,32 +76,15 @@ class Object {
         bool Read(std::string objectFilename);
         bool ReRead(std::string objectFilename);
         void Write(std::string filePath);
-        std::unordered_map<CType, Component*> GetComponentList();
+        const std::array<Component*, Component::typeCount>& GetComponentList() const;
 
         void Clear();
     private:
-            /**
-         * @brief Get a component of the object (const)
-         * 
-         * @tparam T Component class to return
-         * @param type Type of component
-         * @return T* Pointer to the component
-         */
-        template <typename T>
-        T* GetComponentConst() const {
-              // Searching for component using the type (enum as int)
-            auto found = components.find(T::GetCType());
-            if (found == components.end()) {
-                return nullptr;
-            }
-              // Cast found component into correct type
-            return (T*)found->second;
-        }
-    private:
-        std::unordered_map<CType, Component*> components; //!< List of components
+        std::array<Component*, Component::typeCount> components; //!< Component of each type (index is the CType)
         std::string name;                                 //!< Name of the object
-        std::string templateName;                         //!< Name  of the template file used
+        std::shared_ptr<const Prototype> prototype;       //!< Template the object was made from (shared)
         int id;                                           //!< Location of object in object_manager
+        unsigned entity;                                  //!< Index of the object's data in Component_Storage
 };
 
 #endif
\ No newline at end of file
@@ -10,16 +10,44 @@
  */
 
 // std includes //
+#include <cmath>
+#include <random>
 #include <string>
 
 // Engine includes //
 #include "behavior.hpp"
+#include "collision.hpp"
+#include "command_buffer.hpp"
+#include "component_storage.hpp"
+#include "engine.hpp"
+#include "force_field.hpp"
+#include "integrator.hpp"
+#include "model.hpp"
+#include "neighbor_list.hpp"
 #include "object_manager.hpp"
+#include "physics.hpp"
 #include "trace.hpp"
 #include "transform.hpp"
 
 static Object_Manager* object_manager = nullptr; //!< Object_Manager object
 
+static const unsigned slotBits = 22;                          //!< Bits of an id used for the slot
+static const unsigned slotMask = (1u << slotBits) - 1;        //!< Mask for the slot part of an id
+static const unsigned generationMask = (1u << (31 - slotBits)) - 1; //!< Mask for the generation part of an id
+
+/**
+ * @brief Frees the memory of the pool of T, or says how many T are still
+ *        around (and keep the pool from being freed)
+ * 
+ * @tparam T Pooled class
+ * @param name Name of the class
+ */
+template <typename T>
+static void ReleasePool(std::string name) {
+    if (T::ReleasePool()) return;
+    Trace::Message(name + " pool was not freed, " + std::to_string(T::GetPoolUsedCount()) + " are still in use.\n");
+}
+
 /**
  * @brief Initializes the object_manager object. Reads in objects for the given
  *        preset
@@ -64,26 +92,60 @@ bool Object_Manager::Initialize() {
 }
 
 /**
- * @brief Adds object to object_manager
+ * @brief Adds object to object_manager and gives it an id (slot and generation).
+ *        Fails when every slot an id can point at has been used
  * 
- * @param object Object to be added
- * @return void
+ * @param object Object to be added (left to the caller if it isn't added)
+ * @return true
+ * @return false
  */
-void Object_Manager::AddObject(Object* object) {
-      // Tells object its location in object_manager object list
-    object->SetId(object_manager->objects.size());
+bool Object_Manager::AddObject(Object* object) {
+      // Reusing a free slot if there is one
+    unsigned slot;
+    if (!object_manager->freeSlots.empty()) {
+        slot = object_manager->freeSlots.front();
+        object_manager->freeSlots.pop_front();
+    }
+    else {
+        slot = object_manager->slots.size();
+        if (slot > slotMask) {
+            Trace::Message("Object Manager ran out of object ids.\n");
+            return false;
+        }
+        object_manager->slots.emplace_back(Slot{ -1, 0 });
+    }
+
+      // Tells object its id and adds it to the end of the list
+    object_manager->slots[slot].index = object_manager->objects.size();
+    object->SetId(MakeId(slot, object_manager->slots[slot].generation));
     object_manager->objects.emplace_back(object);
+
+      // Systems only see the components from here on
+    object->StoreComponents();
+
+      // Adding the name to the name index (names set before the object was
+      // added weren't checked against the other objects)
+    object->SetName(object->GetName());
+    return true;
 }
 
 /**
- * @brief Finds a object using its id (location in object list) giving instant access
+ * @brief Finds a object using its id. Returns nullptr if the object was removed
+ *        (even if its slot has been reused)
  * 
- * @param id Location of object in object_manager object list
+ * @param id Id given to the object by AddObject
  * @return Object* 
  */
 Object* Object_Manager::FindObject(int id) {
-    if (id >= (int)object_manager->objects.size()) return nullptr;
-    return object_manager->objects[id];
+    if (id < 0) return nullptr;
+
+    unsigned slot = unsigned(id) & slotMask;
+    unsigned generation = unsigned(id) >> slotBits;
+    if (slot >= object_manager->slots.size()) return nullptr;
+
+    const Slot& found = object_manager->slots[slot];
+    if (found.index == -1 || found.generation != generation) return nullptr;
+    return object_manager->objects[found.index];
 }
 
 /**
@@ -93,12 +155,22 @@ Object* Object_Manager::FindObject(int id) {
  * @return Object* 
  */
 Object* Object_Manager::FindObject(std::string objectName) {
-    for (Object* object : object_manager->objects) {
-        if (objectName.compare(object->GetName()) == 0)
-            return object;
-    }
+    auto found = object_manager->names.find(objectName);
+    if (found == object_manager->names.end()) return nullptr;
+
+    return FindObject(found->second);
+}
 
-    return nullptr;
+/**
+ * @brief Returns the object at the given location in the object list. Used to
+ *        loop over every object, locations change when objects are removed
+ * 
+ * @param index Location in the object list (0 to GetSize())
+ * @return Object* 
+ */
+Object* Object_Manager::GetObjectAt(unsigned index) {
+    if (index >= object_manager->objects.size()) return nullptr;
+    return object_manager->objects[index];
 }
 
 /**
@@ -109,14 +181,51 @@ Object* Object_Manager::FindObject(std::string objectName) {
 unsigned Object_Manager::GetSize() { return object_manager->objects.size(); }
 
 /**
- * @brief Calls the update function for each object in the object list
+ * @brief Makes room for count more objects, so adding many objects in a row
+ *        doesn't move the lists each time
+ * 
+ * @param count Number of objects about to be added
+ * @return void
+ */
+void Object_Manager::Reserve(unsigned count) {
+    object_manager->objects.reserve(object_manager->objects.size() + count);
+    object_manager->slots.reserve(object_manager->slots.size() + count);
+    object_manager->names.reserve(object_manager->names.size() + count);
+}
+
+/**
+ * @brief Runs one fixed step for every object in phases. Each phase finishes
+ *        for every object before the next one starts
  * 
  * @return void
  */
 void Object_Manager::Update() {
-    for (unsigned i = 0; i < object_manager->objects.size(); ++i) {
-        object_manager->FindObject(i)->Update();
+    std::vector<Object*>& objects = object_manager->objects;
+
+      // Lists of nearby bodies are checked before scripts can ask for them
+    Neighbor_List::Update();
+
+      // Force accumulation, scripts stay on the main thread (lua states aren't
+      // thread safe). Gravity asked for here is found for every body at once
+      // by the Integrator
+    for (Object* object : objects) {
+          // Objects created or destroyed by scripts wait in the Command_Buffer
+          // until the step is over, so the list doesn't change here
+        Behavior* behavior = object->GetComponent<Behavior>();
+        if (behavior) behavior->Update();
     }
+
+      // Forces declared by the preset, added to every body in one pass
+    Force_Field::Update();
+
+      // Integration and transform write-back (method chosen by the preset)
+    Integrator::Step();
+
+      // Touching bodies are bounced apart (or merged) at their new positions
+    Collision::Update();
+
+      // Bodies that ended the step resting fall asleep
+    Integrator::Settle();
 }
 
 /**
@@ -128,12 +237,19 @@ void Object_Manager::Shutdown() {
     if (!object_manager) return; // If the object_manager doesn't exist
 
       // Deleting each object in the manager
-    for (unsigned i = 0; i < object_manager->objects.size(); ++i) {
-        Object* object = object_manager->FindObject(i);
+    for (Object* object : object_manager->objects) {
         if (object)
             delete object;
     }
 
+      // Every object and component lives in a pool, so their memory can be
+      // given back a block at a time now that they are deleted
+    ReleasePool<Object>("Object");
+    ReleasePool<Behavior>("Behavior");
+    ReleasePool<Model>("Model");
+    ReleasePool<Physics>("Physics");
+    ReleasePool<Transform>("Transform");
+
       // Deleting the manager
     delete object_manager;
     object_manager = nullptr;
@@ -157,15 +273,15 @@ void Object_Manager::ReadList(File_Reader& preset) {
 
           // Constructing the object 
         Object* object = new Object;
-        if (!object->Read(std::string(getenv("USERPROFILE")) + "/Documents/pEngine/json/objects/" + template_name)) {
+        if (!object->Read(Engine::GetDataPath() + "json/objects/" + template_name)) {
             delete object; 
             continue;
         }
 
         object->SetName(object_name);
-        object->SetTemplateName(std::string(getenv("USERPROFILE")) + "/Documents/pEngine/json/objects/" + template_name);
+        object->SetTemplateName(Engine::GetDataPath() + "json/objects/" + template_name);
           // Reading in the objects position
-        glm::vec3 position = preset.Read_Object_Position("object_" + std::to_string(object_num));
+        Vec3 position = preset.Read_Object_Position("object_" + std::to_string(object_num));
         glm::vec3 scale = preset.Read_Object_Scale("object_" + std::to_string(object_num));
         Transform* transform = object->GetComponent<Transform>();
         transform->SetPosition(position);
@@ -175,58 +291,210 @@ void Object_Manager::ReadList(File_Reader& preset) {
         behavior->SetupClassesForLua();
 
           // Adding the object to the manager
-        AddObject(object);
+        if (!AddObject(object)) delete object;
 
         ++object_num;
     }
+
+    ReadSpawns(preset);
+}
+
+/**
+ * @brief Reads in groups of objects to spawn from the preset ("spawn_0",
+ *        "spawn_1", ...). Each one gives a template, a count and where to put
+ *        the objects
+ * 
+ * @param preset 
+ */
+void Object_Manager::ReadSpawns(File_Reader& preset) {
+    for (unsigned spawn_num = 0; ; ++spawn_num) {
+        std::string spawnName = "spawn_" + std::to_string(spawn_num);
+        std::string template_name = preset.Read_Member_String(spawnName, "templateName");
+        if (template_name.compare("") == 0) break;
+
+        int count = preset.Read_Member_Int(spawnName, "count");
+        if (count <= 0) continue;
+
+        SpawnObjects(template_name, preset.Read_Member_String(spawnName, "objectName"), unsigned(count),
+            preset.Read_Member_String(spawnName, "distribution"), preset.Read_Member_Real_Vec3(spawnName, "center"),
+            preset.Read_Member_Real_Vec3(spawnName, "size"), preset.Read_Member_Vec3(spawnName, "scale"));
+    }
+}
+
+/**
+ * @brief Creates count objects from one template. The template is read once
+ *        and copied for each object. The objects are added to the object list
+ *        (all at once) at the next Command_Buffer::Apply. Each object with
+ *        scripts still gets its own lua states, made and started at its first
+ *        update
+ * 
+ * @param templateName Filename of the template (in json/objects)
+ * @param objectName Name of the objects (numbers are added to the back)
+ * @param count Number of objects to create
+ * @param distribution How the objects are placed ("grid", "box" or "sphere")
+ * @param center Center of the area the objects are placed in
+ * @param size Size of the area the objects are placed in
+ * @param scale Scale of each object
+ * @return unsigned Number of objects created (0 if the template couldn't be read)
+ */
+unsigned Object_Manager::SpawnObjects(std::string templateName, std::string objectName, unsigned count,
+    std::string distribution, Vec3 center, Vec3 size, glm::vec3 scale) {
+    if (count == 0) return 0;
+
+      // Reading the template once
+    std::string templatePath = Engine::GetDataPath() + "json/objects/" + templateName;
+    Object prototype;
+    if (!prototype.Read(templatePath)) {
+        Trace::Message("Failed to read spawn template: " + templateName + "\n");
+        return 0;
+    }
+    prototype.SetTemplateName(templatePath);
+    if (objectName.compare("") == 0) objectName = templateName.substr(0, templateName.find(".json"));
+
+      // Making room for every object at once (the Transform and Physics copies
+      // of each object hold one more entity, one at a time, until attached)
+    Component_Storage::Reserve(Component_Storage::GetEntityCount() + count + 1);
+
+    std::vector<Vec3> positions = Distribute(count, distribution, center, size);
+    Transform* prototypeTransform = prototype.GetComponent<Transform>();
+
+    for (const Vec3& position : positions) {
+          // Placing the template first so scripts start with the right position
+        prototypeTransform->SetPosition(position);
+        prototypeTransform->SetStartPosition(position);
+        prototypeTransform->SetScale(scale);
+
+          // Names are made unique when the object is added
+        Object* object = new Object(prototype);
+        object->SetName(objectName);
+        Command_Buffer::CreateObject(object);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Finds positions for count objects
+ * 
+ * @param count Number of positions
+ * @param distribution "grid" (evenly spaced), "sphere" (random inside the
+ *        sphere that fits in size) or "box" (random inside size)
+ * @param center Center of the area
+ * @param size Size of the area
+ * @return std::vector<Vec3> 
+ */
+std::vector<Vec3> Object_Manager::Distribute(unsigned count, std::string distribution, Vec3 center, Vec3 size) {
+    std::vector<Vec3> positions;
+    positions.reserve(count);
+    Vec3 corner = center - size * Real(0.5);
+
+    if (distribution.compare("grid") == 0) {
+          // Smallest cube of points that fits count
+        unsigned side = unsigned(std::ceil(std::cbrt(double(count))));
+        while (side * side * side < count) ++side;
+        Vec3 spacing = side > 1 ? size / Real(side - 1) : Vec3(0);
+        if (side == 1) corner = center;
+
+        for (unsigned i = 0; i < count; ++i) {
+            Vec3 cell(Real(i % side), Real((i / side) % side), Real(i / (side * side)));
+            positions.emplace_back(corner + cell * spacing);
+        }
+        return positions;
+    }
+
+      // One generator for the whole batch
+    std::mt19937 gen(std::random_device{}());
+    std::uniform_real_distribution<Real> dist(Real(-0.5), Real(0.5));
+
+    if (distribution.compare("sphere") == 0) {
+        while (positions.size() < count) {
+            Vec3 point(dist(gen), dist(gen), dist(gen));
+            if (glm::dot(point, point) > Real(0.25)) continue;
+            positions.emplace_back(center + point * size);
+        }
+        return positions;
+    }
+
+    if (distribution.compare("box") != 0)
+        Trace::Message("Unknown spawn distribution \"" + distribution + "\", using box.\n");
+
+    for (unsigned i = 0; i < count; ++i) {
+        positions.emplace_back(center + Vec3(dist(gen), dist(gen), dist(gen)) * size);
+    }
+    return positions;
 }
 
 /**
  * @brief Checks if the name of the given object is already being used. If it is
- *        being used it applies a number to the back.
+ *        being used it applies a number to the back. When the id belongs to an
+ *        object in the manager the name index is updated to the returned name
  * 
  * @param objectName 
  * @param id 
  * @return std::string 
  */
 std::string Object_Manager::CheckName(std::string objectName, int id) {
-      // Checking if the name matches any other objects
-    int objWithName = 0;
-    for (Object* objToCheck : object_manager->objects) {
-        if (id != -1 && objToCheck->GetId() == id) continue;
-        if (objToCheck->GetName().find(objectName) != std::string::npos)
-            ++objWithName;
+    std::unordered_map<std::string, int>& names = object_manager->names;
+    Object* object = FindObject(id);
+
+      // Taking the object's old name out of the index
+    if (object) {
+        auto oldName = names.find(object->GetName());
+        if (oldName != names.end() && oldName->second == id)
+            names.erase(oldName);
+    }
+
+      // Finding a suffix that isn't in use yet
+    std::string uniqueName = objectName;
+    if (names.find(uniqueName) != names.end()) {
+        unsigned& count = object_manager->nameCounts[objectName];
+        do {
+            uniqueName = objectName + "_" + std::to_string(++count);
+        } while (names.find(uniqueName) != names.end());
     }
 
-      // Updating the name
-    if (objWithName > 0)
-        return objectName + "_" + std::to_string(objWithName);
-    
-    return objectName;
+    if (object)
+        names[uniqueName] = id;
+
+    return uniqueName;
 }
 
 /**
- * @brief Removes an object from the object_manager
+ * @brief Removes an object from the object_manager. The last object is moved
+ *        into its place and the id stops being valid
  * 
  * @param id id of object to remove
  * @return void
  */
 void Object_Manager::RemoveObject(int id) {
-    if (id >= (int)object_manager->objects.size()) return;
-    Object* objectToDelete = object_manager->objects[id];
+    Object* objectToDelete = FindObject(id);
+    if (!objectToDelete) return;
+
+    Slot& slot = object_manager->slots[unsigned(id) & slotMask];
+    std::vector<Object*>& objects = object_manager->objects;
+
+      // Moving the last object into the hole
+    Object* last = objects.back();
+    objects[slot.index] = last;
+    object_manager->slots[unsigned(last->GetId()) & slotMask].index = slot.index;
+    objects.pop_back();
 
-      // Moves all the objects to the right of one being deleted to the left
-    unsigned offset = 0;
-    for (unsigned objectNum = id + 1; objectNum < object_manager->objects.size(); ++objectNum) {
-        Object* objectToSwitch = object_manager->objects[objectNum];
-        object_manager->objects[id + offset] = objectToSwitch;
-        objectToSwitch->SetId(id + offset++);
+      // Taking the name out of the index
+    auto name = object_manager->names.find(objectToDelete->GetName());
+    if (name != object_manager->names.end() && name->second == id)
+        object_manager->names.erase(name);
+
+      // Freeing the slot, old ids no longer match its generation. A slot whose
+      // generation would wrap is never reused, so old ids can't match again
+    slot.index = -1;
+    if (slot.generation < generationMask) {
+        ++slot.generation;
+        object_manager->freeSlots.emplace_back(unsigned(id) & slotMask);
     }
 
       // Deleting the object
     delete objectToDelete;
     objectToDelete = nullptr;
-    object_manager->objects.pop_back();
 }
 
 /**
@@ -236,7 +504,18 @@ void Object_Manager::RemoveObject(int id) {
  * @return void
  */
 void Object_Manager::Write(File_Writer& writer) {
-    for (Object* object : object_manager->objects) {
-        writer.Write_Object_Data(object);
+    for (unsigned i = 0; i < object_manager->objects.size(); ++i) {
+        writer.Write_Object_Data(object_manager->objects[i], i);
     }
 }
+
+/**
+ * @brief Packs a slot and generation into an id
+ * 
+ * @param slot 
+ * @param generation 
+ * @return int 
+ */
+int Object_Manager::MakeId(unsigned slot, unsigned generation) {
+    return int((generation << slotBits) | slot);
+}
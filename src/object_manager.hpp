@@ -14,22 +14,33 @@
 #define OBJECT_MANAGER_HPP
 
 // std includes //
+#include <deque>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+// Library includes //
+#include <vec3.hpp>
+
 // Engine includes //
 #include "object.hpp"
 #include "file_reader.hpp"
 #include "file_writer.hpp"
+#include "precision.hpp"
 
 /*! Object_Manager class */
 class Object_Manager {
     public:
         static bool Initialize(File_Reader& preset);
         static bool Initialize();
-        static void AddObject(Object* object);
+        static bool AddObject(Object* object);
+        static unsigned SpawnObjects(std::string templateName, std::string objectName, unsigned count,
+            std::string distribution, Vec3 center, Vec3 size, glm::vec3 scale);
         static Object* FindObject(int id);
         static Object* FindObject(std::string objectName);
+        static Object* GetObjectAt(unsigned index);
         static unsigned GetSize();
+        static void Reserve(unsigned count);
         static void Update();
         static void Shutdown();
         void ReadList(File_Reader& preset);
@@ -37,7 +48,21 @@ class Object_Manager {
         static void RemoveObject(int id);
         static void Write(File_Writer& writer);
     private:
-        std::vector<Object*> objects; //!< Current objects being tracked by the engine
+        void ReadSpawns(File_Reader& preset);
+        static std::vector<Vec3> Distribute(unsigned count, std::string distribution, Vec3 center, Vec3 size);
+        static int MakeId(unsigned slot, unsigned generation);
+
+        /*! Slot an id points at */
+        struct Slot {
+            int index;           //!< Location of the object in objects (-1 if the slot is free)
+            unsigned generation; //!< Bumped each time the slot is freed, so old ids stop matching
+        };
+    private:
+        std::vector<Object*> objects; //!< Current objects being tracked by the engine (packed)
+        std::vector<Slot> slots;      //!< Slot of each id
+        std::deque<unsigned> freeSlots; //!< Free slots, reused oldest first so generations last longer
+        std::unordered_map<std::string, int> names;         //!< Id of the object using each name
+        std::unordered_map<std::string, unsigned> nameCounts; //!< Last suffix given out for each base name
 };
 
 #endif
\ No newline at end of file
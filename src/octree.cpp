@@ -0,0 +1,268 @@
+/**
+ * @file octree.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-02
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// std includes //
+#include <algorithm>
+#include <cmath>
+
+// Library includes //
+#include <glm.hpp>
+
+// Engine includes //
+#include "octree.hpp"
+
+static const int maxDepth = 32; //!< Bodies closer than this are kept in a list in one leaf
+
+/**
+ * @brief Creates an empty octree
+ *
+ */
+Octree::Octree() : positions(nullptr), masses(nullptr) {}
+
+/**
+ * @brief Builds the tree over the given bodies. The arrays need to stay alive
+ *        until the tree is rebuilt or cleared
+ *
+ * @param positions_ Position of each body
+ * @param masses_ Mass of each body
+ */
+void Octree::Build(const std::vector<Vec3>& positions_, const std::vector<Real>& masses_) {
+    Clear();
+    positions = &positions_;
+    masses = &masses_;
+    if (positions->empty()) return;
+
+      // Finding the bounds of all the bodies
+    Vec3 minBound = (*positions)[0];
+    Vec3 maxBound = (*positions)[0];
+    for (const Vec3& position : *positions) {
+        minBound = glm::min(minBound, position);
+        maxBound = glm::max(maxBound, position);
+    }
+
+      // Root is a cube that contains every body
+    Vec3 extent = maxBound - minBound;
+    Real halfSize = Real(0.5) * std::max(extent.x, std::max(extent.y, extent.z)) + Real(1e-3);
+    nodes.reserve(positions->size() * 2);
+    nextBody.assign(positions->size(), -1);
+    CreateNode(Real(0.5) * (minBound + maxBound), halfSize, 0);
+
+      // Adding each body, then finding the center of mass of each cell
+    for (int body = 0; body < (int)positions->size(); ++body) {
+        Insert(body);
+    }
+    Summarize();
+}
+
+/**
+ * @brief Finds the gravitational acceleration (without the gravitational
+ *        constant) that every other body applies on the given body
+ *
+ * @param body Index of the body
+ * @param openingAngle Cells with size / distance below this are treated as one body
+ * @return Vec3
+ */
+Vec3 Octree::ComputeAcceleration(int body, Real openingAngle) const {
+    Vec3 acceleration(0);
+    if (nodes.empty()) return acceleration;
+
+    const Vec3 position = (*positions)[body];
+    const Real openingAngleSq = openingAngle * openingAngle;
+
+      // Walking the tree without recursion
+    int stack[8 * maxDepth + 8];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const Node& node = nodes[stack[--stackSize]];
+        if (node.mass <= Real(0)) continue;
+
+          // Leaf, every body in it is used directly
+        if (node.firstChild == -1) {
+            for (int other = node.firstBody; other != -1; other = nextBody[other]) {
+                if (other == body) continue;
+                Vec3 direction = (*positions)[other] - position;
+                Real distanceSq = glm::dot(direction, direction);
+                if (distanceSq <= Real(0)) continue;
+                Real invDistance = Real(1) / std::sqrt(distanceSq);
+                acceleration += direction * ((*masses)[other] * invDistance * invDistance * invDistance);
+            }
+            continue;
+        }
+
+        Vec3 direction = node.centerOfMass - position;
+        Real distanceSq = glm::dot(direction, direction);
+        Real size = Real(2) * node.halfSize;
+
+          // Cell is far enough away (and doesn't hold this body) to be used as one body
+        Vec3 offset = glm::abs(position - node.center);
+        bool inside = offset.x <= node.halfSize && offset.y <= node.halfSize && offset.z <= node.halfSize;
+        if (!inside && size * size < openingAngleSq * distanceSq) {
+            Real invDistance = Real(1) / std::sqrt(distanceSq);
+            acceleration += direction * (node.mass * invDistance * invDistance * invDistance);
+            continue;
+        }
+
+          // Too close, check the children
+        for (int child = 0; child < 8; ++child) {
+            stack[stackSize++] = node.firstChild + child;
+        }
+    }
+
+    return acceleration;
+}
+
+/**
+ * @brief Removes all nodes from the tree
+ *
+ */
+void Octree::Clear() {
+    nodes.clear();
+    nextBody.clear();
+    positions = nullptr;
+    masses = nullptr;
+}
+
+/**
+ * @brief Returns the number of nodes in the tree
+ *
+ * @return unsigned
+ */
+unsigned Octree::GetNodeCount() const { return nodes.size(); }
+
+/**
+ * @brief Adds an empty leaf node to the tree
+ *
+ * @param center Center of the cell
+ * @param halfSize Half of the width of the cell
+ * @param depth Depth of the node
+ * @return int Index of the new node
+ */
+int Octree::CreateNode(Vec3 center, Real halfSize, int depth) {
+    Node node;
+    node.center = center;
+    node.halfSize = halfSize;
+    node.centerOfMass = Vec3(0);
+    node.mass = Real(0);
+    node.firstChild = -1;
+    node.firstBody = -1;
+    node.depth = depth;
+
+    nodes.emplace_back(node);
+    return (int)nodes.size() - 1;
+}
+
+/**
+ * @brief Inserts a body into the tree, splitting leaves as needed
+ *
+ * @param body Index of the body
+ */
+void Octree::Insert(int body) {
+    const Vec3 position = (*positions)[body];
+    int nodeId = 0;
+
+    while (true) {
+          // Internal node, move down to the child containing the body
+        if (nodes[nodeId].firstChild != -1) {
+            nodeId = nodes[nodeId].firstChild + GetOctant(nodes[nodeId], position);
+            continue;
+        }
+
+          // Empty leaf or leaf that can't be split anymore
+        if (nodes[nodeId].firstBody == -1 || nodes[nodeId].depth >= maxDepth) {
+            nextBody[body] = nodes[nodeId].firstBody;
+            nodes[nodeId].firstBody = body;
+            return;
+        }
+
+          // Leaf already has a body, split it and try again
+        Subdivide(nodeId);
+    }
+}
+
+/**
+ * @brief Splits a leaf into 8 children and moves its bodies into them
+ *
+ * @param nodeId Index of the leaf
+ */
+void Octree::Subdivide(int nodeId) {
+    const Real childHalfSize = Real(0.5) * nodes[nodeId].halfSize;
+    const Vec3 center = nodes[nodeId].center;
+    const int depth = nodes[nodeId].depth + 1;
+
+      // Children are stored next to each other
+    int firstChild = (int)nodes.size();
+    for (int child = 0; child < 8; ++child) {
+        Vec3 offset((child & 1) ? childHalfSize : -childHalfSize,
+                    (child & 2) ? childHalfSize : -childHalfSize,
+                    (child & 4) ? childHalfSize : -childHalfSize);
+        CreateNode(center + offset, childHalfSize, depth);
+    }
+
+      // Moving the bodies of the leaf into the children
+    int body = nodes[nodeId].firstBody;
+    nodes[nodeId].firstBody = -1;
+    nodes[nodeId].firstChild = firstChild;
+    while (body != -1) {
+        int next = nextBody[body];
+        Node& child = nodes[firstChild + GetOctant(nodes[nodeId], (*positions)[body])];
+        nextBody[body] = child.firstBody;
+        child.firstBody = body;
+        body = next;
+    }
+}
+
+/**
+ * @brief Finds which child of the node the position is in
+ *
+ * @param node
+ * @param position
+ * @return int Index of the child (0-7)
+ */
+int Octree::GetOctant(const Node& node, Vec3 position) const {
+    int octant = 0;
+    if (position.x >= node.center.x) octant |= 1;
+    if (position.y >= node.center.y) octant |= 2;
+    if (position.z >= node.center.z) octant |= 4;
+    return octant;
+}
+
+/**
+ * @brief Finds the total mass and center of mass of every cell. Children are
+ *        always created after their parent, so going backwards visits children
+ *        first
+ *
+ */
+void Octree::Summarize() {
+    for (int nodeId = (int)nodes.size() - 1; nodeId >= 0; --nodeId) {
+        Node& node = nodes[nodeId];
+        Vec3 weighted(0);
+        Real mass = Real(0);
+
+        if (node.firstChild == -1) {
+            for (int body = node.firstBody; body != -1; body = nextBody[body]) {
+                weighted += (*positions)[body] * (*masses)[body];
+                mass += (*masses)[body];
+            }
+        }
+        else {
+            for (int child = 0; child < 8; ++child) {
+                const Node& childNode = nodes[node.firstChild + child];
+                weighted += childNode.centerOfMass * childNode.mass;
+                mass += childNode.mass;
+            }
+        }
+
+        node.mass = mass;
+        node.centerOfMass = (mass > Real(0)) ? weighted / mass : node.center;
+    }
+}
@@ -0,0 +1,59 @@
+/**
+ * @file octree.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-02
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef OCTREE_HPP
+#define OCTREE_HPP
+
+// std includes //
+#include <vector>
+
+// Library includes //
+#include <vec3.hpp>
+
+// Engine includes //
+#include "precision.hpp"
+
+/*! Octree class (Barnes-Hut) */
+class Octree {
+    public:
+        Octree();
+
+        void Build(const std::vector<Vec3>& positions_, const std::vector<Real>& masses_);
+        Vec3 ComputeAcceleration(int body, Real openingAngle) const;
+        void Clear();
+
+        unsigned GetNodeCount() const;
+    private:
+        /*! Node of the octree */
+        struct Node {
+            Vec3 center;            //!< Center of the cell
+            Real halfSize;          //!< Half of the width of the cell
+            Vec3 centerOfMass;      //!< Mass weighted position of the bodies in the cell
+            Real mass;              //!< Total mass of the bodies in the cell
+            int firstChild;         //!< Index of the first of 8 children (-1 if leaf)
+            int firstBody;          //!< First body in the leaf (-1 if empty or internal)
+            int depth;              //!< Depth of the node in the tree
+        };
+
+        int CreateNode(Vec3 center, Real halfSize, int depth);
+        void Insert(int body);
+        void Subdivide(int nodeId);
+        int GetOctant(const Node& node, Vec3 position) const;
+        void Summarize();
+    private:
+        std::vector<Node> nodes;                  //!< Nodes of the tree (root is 0)
+        std::vector<int> nextBody;                //!< Next body in the same leaf (-1 at end)
+        const std::vector<Vec3>* positions;       //!< Positions of the bodies in the tree
+        const std::vector<Real>* masses;          //!< Masses of the bodies in the tree
+};
+
+#endif
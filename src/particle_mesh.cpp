@@ -0,0 +1,223 @@
+/**
+ * @file particle_mesh.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-19
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// std includes //
+#include <algorithm>
+#include <cmath>
+
+// Library includes //
+#include <glm.hpp>
+
+// Engine includes //
+#include "fft.hpp"
+#include "job_system.hpp"
+#include "particle_mesh.hpp"
+
+static const unsigned minSize = 8;   //!< Fewest cells along a side (a margin of 2 or 3 cells is kept on each side)
+static const unsigned maxSize = 256; //!< Most cells along a side (the padded grid is 8 times as many cells)
+
+/**
+ * @brief Returns the cell the body is in and how far into it the body is
+ *        (cloud in cell weights along each axis)
+ *
+ */
+static inline glm::uvec3 Locate(Vec3 position, Vec3 origin, Real cellSize, Vec3& fraction) {
+    Vec3 coordinates = (position - origin) / cellSize;
+    Vec3 cell = glm::floor(coordinates);
+    fraction = coordinates - cell;
+    return glm::uvec3(cell);
+}
+
+/**
+ * @brief Creates a mesh that is turned off
+ *
+ */
+Particle_Mesh::Particle_Mesh() : origin(0), cellSize(Real(1)), size(0) {}
+
+/**
+ * @brief Finds the gravitational acceleration (without the gravitational
+ *        constant) of every body. The mass of each body is spread over the 8
+ *        cells around it, the potential of the grid is found by convolving it
+ *        with the potential of a unit mass (a product after an FFT), and the
+ *        slope of the potential is read back at each body with the same
+ *        weights. The grid is padded to twice the size with empty cells so
+ *        the bodies aren't pulled by copies of themselves (isolated, not
+ *        periodic). Bodies closer than about a cell pull on each other less
+ *        than they would with exact forces
+ *
+ * @param posX Position of each body (x)
+ * @param posY Position of each body (y)
+ * @param posZ Position of each body (z)
+ * @param masses Mass of each body
+ * @param accelX Resulting acceleration (x)
+ * @param accelY Resulting acceleration (y)
+ * @param accelZ Resulting acceleration (z)
+ * @param count Number of bodies
+ */
+void Particle_Mesh::Compute(const Real* posX, const Real* posY, const Real* posZ, const Real* masses,
+    Real* accelX, Real* accelY, Real* accelZ, unsigned count) {
+    if (size == 0 || count == 0) return;
+    if (green.empty()) BuildGreen();
+
+      // Grid covers the bodies with a margin of a cell and a half, so the
+      // cells a body touches and their neighbors are always inside it (with
+      // room for rounding)
+    Vec3 minBound(posX[0], posY[0], posZ[0]);
+    Vec3 maxBound = minBound;
+    for (unsigned body = 1; body < count; ++body) {
+        Vec3 position(posX[body], posY[body], posZ[body]);
+        minBound = glm::min(minBound, position);
+        maxBound = glm::max(maxBound, position);
+    }
+    Vec3 extent = maxBound - minBound;
+    Real largest = std::max(extent.x, std::max(extent.y, extent.z));
+    cellSize = std::max(largest, Real(1e-3)) / Real(size - 5);
+    origin = minBound - Vec3(Real(1.5) * cellSize);
+
+      // Each thread spreads its bodies onto its own grid
+    const unsigned cells = size * size * size;
+    const unsigned threads = Job_System::GetThreadCount();
+    threadMass.assign(threads * cells, Real(0));
+    Job_System::ParallelFor(count, 4096, [=](unsigned begin, unsigned end) {
+        Real* own = threadMass.data() + Job_System::GetThreadIndex() * cells;
+        for (unsigned body = begin; body < end; ++body) {
+            Vec3 fraction;
+            glm::uvec3 cell = Locate(Vec3(posX[body], posY[body], posZ[body]), origin, cellSize, fraction);
+            for (unsigned z = 0; z < 2; ++z) {
+                for (unsigned y = 0; y < 2; ++y) {
+                    for (unsigned x = 0; x < 2; ++x) {
+                        Real weight = (x ? fraction.x : Real(1) - fraction.x) *
+                            (y ? fraction.y : Real(1) - fraction.y) * (z ? fraction.z : Real(1) - fraction.z);
+                        own[((cell.z + z) * size + cell.y + y) * size + cell.x + x] += masses[body] * weight;
+                    }
+                }
+            }
+        }
+    });
+
+      // Adding up the grids of each thread into the corner of the padded grid
+    const unsigned padded = 2 * size;
+    grid.assign(padded * padded * padded, std::complex<Real>(0));
+    Job_System::ParallelFor(size * size, 16, [=](unsigned begin, unsigned end) {
+        for (unsigned row = begin; row < end; ++row) {
+            unsigned y = row % size, z = row / size;
+            std::complex<Real>* cell = grid.data() + (z * padded + y) * padded;
+            for (unsigned thread = 0; thread < threads; ++thread) {
+                const Real* own = threadMass.data() + thread * cells + row * size;
+                for (unsigned x = 0; x < size; ++x) cell[x] += own[x];
+            }
+        }
+    });
+
+      // Potential of every cell
+    FFT::Transform3D(grid.data(), padded, false);
+    Job_System::ParallelFor(grid.size(), 4096, [this](unsigned begin, unsigned end) {
+        for (unsigned k = begin; k < end; ++k) grid[k] *= green[k];
+    });
+    FFT::Transform3D(grid.data(), padded, true);
+
+      // Slope of the potential (central differences) at the cells around each
+      // body, weighted the same way its mass was spread
+    const Real scale = Real(-0.5) / (cellSize * cellSize);
+    Job_System::ParallelFor(count, 1024, [=](unsigned begin, unsigned end) {
+        for (unsigned body = begin; body < end; ++body) {
+            Vec3 fraction;
+            glm::uvec3 cell = Locate(Vec3(posX[body], posY[body], posZ[body]), origin, cellSize, fraction);
+            Vec3 slope(0);
+            for (unsigned z = cell.z; z < cell.z + 2; ++z) {
+                for (unsigned y = cell.y; y < cell.y + 2; ++y) {
+                    for (unsigned x = cell.x; x < cell.x + 2; ++x) {
+                        Real weight = (x > cell.x ? fraction.x : Real(1) - fraction.x) *
+                            (y > cell.y ? fraction.y : Real(1) - fraction.y) *
+                            (z > cell.z ? fraction.z : Real(1) - fraction.z);
+                        slope += weight * Vec3(Potential(x + 1, y, z) - Potential(x - 1, y, z),
+                            Potential(x, y + 1, z) - Potential(x, y - 1, z),
+                            Potential(x, y, z + 1) - Potential(x, y, z - 1));
+                    }
+                }
+            }
+
+            accelX[body] = slope.x * scale;
+            accelY[body] = slope.y * scale;
+            accelZ[body] = slope.z * scale;
+        }
+    });
+}
+
+/**
+ * @brief Sets the number of cells along each side (rounded up to a power of
+ *        two, 0 turns the mesh off)
+ *
+ * @param size_
+ * @return void
+ */
+void Particle_Mesh::SetSize(unsigned size_) {
+    unsigned newSize = 0;
+    if (size_ > 0) {
+        newSize = minSize;
+        while (newSize < size_ && newSize < maxSize) newSize <<= 1;
+    }
+    if (newSize == size) return;
+
+    size = newSize;
+    green.clear();
+    grid.clear();
+    threadMass.clear();
+}
+
+/**
+ * @brief Returns the number of cells along each side (0 when off)
+ *
+ * @return unsigned
+ */
+unsigned Particle_Mesh::GetSize() const { return size; }
+
+/**
+ * @brief Finds the transform of the potential of a unit mass, -1 / distance in
+ *        cells (-1 in its own cell). Distances past half the padded grid are
+ *        negative, so the convolution is the same as on an unbounded grid.
+ *        Only depends on the size, the cell width is applied afterwards
+ *
+ */
+void Particle_Mesh::BuildGreen() {
+    const unsigned padded = 2 * size;
+    const Real normalize = Real(1) / (Real(padded) * Real(padded) * Real(padded));
+    green.assign(padded * padded * padded, std::complex<Real>(0));
+
+    Job_System::ParallelFor(padded, 1, [this, padded, normalize](unsigned begin, unsigned end) {
+        for (unsigned z = begin; z < end; ++z) {
+            for (unsigned y = 0; y < padded; ++y) {
+                for (unsigned x = 0; x < padded; ++x) {
+                    Vec3 offset(x < size ? Real(x) : Real(x) - Real(padded),
+                        y < size ? Real(y) : Real(y) - Real(padded),
+                        z < size ? Real(z) : Real(z) - Real(padded));
+                    Real distance = glm::length(offset);
+                    Real potential = distance > Real(0) ? Real(-1) / distance : Real(-1);
+
+                      // Inverse transform isn't scaled, so it's done here once
+                    green[(z * padded + y) * padded + x] = potential * normalize;
+                }
+            }
+        }
+    });
+
+    FFT::Transform3D(green.data(), padded, false);
+}
+
+/**
+ * @brief Returns the potential of the cell (in cells, not yet divided by the
+ *        cell width)
+ *
+ */
+Real Particle_Mesh::Potential(unsigned x, unsigned y, unsigned z) const {
+    const unsigned padded = 2 * size;
+    return grid[(z * padded + y) * padded + x].real();
+}
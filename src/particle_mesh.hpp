@@ -0,0 +1,47 @@
+/**
+ * @file particle_mesh.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-19
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef PARTICLE_MESH_HPP
+#define PARTICLE_MESH_HPP
+
+// std includes //
+#include <complex>
+#include <vector>
+
+// Library includes //
+#include <vec3.hpp>
+
+// Engine includes //
+#include "precision.hpp"
+
+/*! Particle_Mesh class (gravity of many bodies found on a grid with FFTs) */
+class Particle_Mesh {
+    public:
+        Particle_Mesh();
+
+        void Compute(const Real* posX, const Real* posY, const Real* posZ, const Real* masses,
+            Real* accelX, Real* accelY, Real* accelZ, unsigned count);
+        void SetSize(unsigned size_);
+        unsigned GetSize() const;
+    private:
+        void BuildGreen();
+        Real Potential(unsigned x, unsigned y, unsigned z) const;
+    private:
+        std::vector<std::complex<Real>> green;   //!< Transform of the potential of a unit mass (padded grid)
+        std::vector<std::complex<Real>> grid;    //!< Mass, then potential, of each cell (padded grid)
+        std::vector<Real> threadMass;            //!< Mass each thread spread onto the grid (size^3 each)
+        Vec3 origin;                             //!< Position of cell (0, 0, 0) this step
+        Real cellSize;                           //!< Width of a cell this step
+        unsigned size;                           //!< Cells along each side covering the bodies (0 is off)
+};
+
+#endif
@@ -9,37 +9,59 @@
  * 
  */
 
-// std includes //
-#include <cmath>
-
 // Library includes //
 #include <glm.hpp>
 
 // Engine includes
-  // System
-#include "engine.hpp"
   // Object
-#include "object_manager.hpp"
 #include "object.hpp"
   // Component
+#include "component_storage.hpp"
 #include "physics.hpp"
-#include "transform.hpp"
+  // System
+#include "gravity.hpp"
+#include "neighbor_list.hpp"
 
 /**
- * @brief Creates Physics object with default values
+ * @brief Creates Physics object with default values. Data is kept in its own
+ *        entity until the component is attached to an object
  * 
  */
-Physics::Physics() : Component(CType::CPhysics),
-    acceleration(glm::vec3(0.f, 0.f, 0.f)), forces(glm::vec3(0.f, 0.f, 0.f)), 
-    velocity(glm::vec3(0.f, 0.f, 0.f)), rotationalVelocity(glm::vec3(0.f, 0.f, 0.f)), mass(1.f) {}
+Physics::Physics() : Component(GetCType()),
+    entity(Component_Storage::CreateEntity()), ownsEntity(true) {
+    Physics_Data& data = Component_Storage::GetPhysicsData();
+    data.acceleration[entity] = Vec3(0);
+    data.forces[entity] = Vec3(0);
+    data.heldForces[entity] = Vec3(0);
+    data.velocity[entity] = Vec3(0);
+    data.initialVelocity[entity] = Vec3(0);
+    data.initialAcceleration[entity] = Vec3(0);
+    data.rotationalVelocity[entity] = glm::vec3(0.f, 0.f, 0.f);
+    data.mass[entity] = Real(1);
+    data.usesGravity[entity] = 0;
+    data.restTime[entity] = 0.f;
+    data.isSleeping[entity] = 0;
+    data.blockLevel[entity] = Physics_Data::noBlock;
+    data.blockGravity[entity] = Vec3(0);
+    data.endGravity[entity] = Vec3(0);
+    data.hasEndGravity[entity] = 0;
+    data.isUsed[entity] = 1;
+}
 
 /**
  * @brief Copy constructor
  * 
  * @param other Physics object to be copied
  */
-Physics::Physics(const Physics& other) : Component(CType::CPhysics) {
-    *this = other;
+Physics::Physics(const Physics& other) : Physics() {
+    Physics_Data& data = Component_Storage::GetPhysicsData();
+    data.acceleration[entity] = data.acceleration[other.entity];
+    data.forces[entity] = data.forces[other.entity];
+    data.velocity[entity] = data.velocity[other.entity];
+    data.initialVelocity[entity] = data.initialVelocity[other.entity];
+    data.initialAcceleration[entity] = data.initialAcceleration[other.entity];
+    data.rotationalVelocity[entity] = data.rotationalVelocity[other.entity];
+    data.mass[entity] = data.mass[other.entity];
 }
 
 /**
@@ -47,12 +69,19 @@ Physics::Physics(const Physics& other) : Component(CType::CPhysics) {
  * 
  * @param reader File to use for making physics object
  */
-Physics::Physics(File_Reader& reader) : Component(CType::CPhysics),
-    acceleration(glm::vec3(0.f, 0.f, 0.f)), forces(glm::vec3(0.f, 0.f, 0.f)), 
-    velocity(glm::vec3(0.f, 0.f, 0.f)), rotationalVelocity(glm::vec3(0.f, 0.f, 0.f)), mass(1.f) {
+Physics::Physics(File_Reader& reader) : Physics() {
     Read(reader);
 }
 
+/**
+ * @brief Marks the data as unused (and gives back the entity if it's its own)
+ * 
+ */
+Physics::~Physics() {
+    Component_Storage::GetPhysicsData().isUsed[entity] = 0;
+    if (ownsEntity) Component_Storage::ReleaseEntity(entity);
+}
+
 /**
  * @brief Clone Physics object
  * 
@@ -62,54 +91,72 @@ Physics* Physics::Clone() const {
     return new Physics(*this);
 }
 
+/**
+ * @brief Attaches the component to an object and moves its data to the
+ *        object's entity
+ * 
+ * @param object 
+ */
+void Physics::SetParent(Object* object) {
+    Component::SetParent(object);
+    if (object) MoveTo(object->GetEntity());
+}
+
+/**
+ * @brief Returns the entity the data of this component is stored at
+ * 
+ * @return unsigned 
+ */
+unsigned Physics::GetEntity() const { return entity; }
+
 /**
  * @brief Sets acceleration of object
  * 
  * @param accel 
  */
-void Physics::SetAcceleration(glm::vec3 accel) { acceleration = accel; }
+void Physics::SetAcceleration(Vec3 accel) { Component_Storage::GetPhysicsData().acceleration[entity] = accel; }
 
 /**
  * @brief Returns acceleration of object
  * 
- * @return glm::vec3 
+ * @return Vec3 
  */
-glm::vec3 Physics::GetAcceleration() const { return acceleration; }
+Vec3 Physics::GetAcceleration() const { return Component_Storage::GetPhysicsData().acceleration[entity]; }
 
 /**
  * @brief Returns reference to the acceleration of the object
  * 
- * @return glm::vec3& 
+ * @return Vec3& 
  */
-glm::vec3& Physics::GetAccelerationRef() { return acceleration; }
+Vec3& Physics::GetAccelerationRef() { return Component_Storage::GetPhysicsData().acceleration[entity]; }
 
 /**
  * @brief Sets forces acting on object
  * 
  * @param force 
  */
-void Physics::SetForces(glm::vec3 force) { forces = force; }
+void Physics::SetForces(Vec3 force) { Component_Storage::GetPhysicsData().forces[entity] = force; }
 
 /**
  * @brief Adds a force to the current forces acting on the object
  * 
  * @param force 
  */
-void Physics::AddForce(glm::vec3 force) { forces += force; }
+void Physics::AddForce(Vec3 force) { Component_Storage::GetPhysicsData().forces[entity] += force; }
 
 /**
  * @brief Returns the forces acting on the object
  * 
- * @return glm::vec3 
+ * @return Vec3 
  */
-glm::vec3 Physics::GetForces() const { return forces; }
+Vec3 Physics::GetForces() const { return Component_Storage::GetPhysicsData().forces[entity]; }
 
 /**
  * @brief Returns reference to the forces acting on the object
  * 
- * @return glm::vec3& 
+ * @return Vec3& 
  */
-glm::vec3& Physics::GetForcesRef() { return forces; }
+Vec3& Physics::GetForcesRef() { return Component_Storage::GetPhysicsData().forces[entity]; }
 
 /**
  * @brief Applies force in the given direction using the given power
@@ -121,7 +168,7 @@ void Physics::ApplyForce(glm::vec3 direction, float power) {
     direction = glm::normalize(direction);
     direction *= power;
 
-    AddForce(direction);
+    AddForce(Vec3(direction));
 }
 
 /**
@@ -129,124 +176,96 @@ void Physics::ApplyForce(glm::vec3 direction, float power) {
  * 
  * @param vel 
  */
-void Physics::SetVelocity(glm::vec3 vel) { velocity = vel; }
+void Physics::SetVelocity(Vec3 vel) { Component_Storage::GetPhysicsData().velocity[entity] = vel; }
 
 /**
  * @brief Returns the current velocity of the object
  * 
- * @return glm::vec3 
+ * @return Vec3 
  */
-glm::vec3 Physics::GetVelocity() const { return velocity; }
+Vec3 Physics::GetVelocity() const { return Component_Storage::GetPhysicsData().velocity[entity]; }
 
 /**
  * @brief Returns reference to velocity of the object
  * 
- * @return glm::vec3& 
+ * @return Vec3& 
  */
-glm::vec3& Physics::GetVelocityRef() { return velocity; }
+Vec3& Physics::GetVelocityRef() { return Component_Storage::GetPhysicsData().velocity[entity]; }
 
 /**
  * @brief Sets the mass of the object
  * 
  * @param ma 
  */
-void Physics::SetMass(float ma) { mass = ma; }
+void Physics::SetMass(Real ma) {
+    Component_Storage::GetPhysicsData().mass[entity] = ma;
+    Gravity::MarkChanged();
+}
 
 /**
  * @brief Returns the mass of the object
  * 
- * @return float 
+ * @return Real 
  */
-float Physics::GetMass() const { return mass; }
+Real Physics::GetMass() const { return Component_Storage::GetPhysicsData().mass[entity]; }
 
 /**
  * @brief Returns reference to mass of the object
  * 
- * @return float& 
+ * @return Real& 
  */
-float& Physics::GetMassRef() { return mass; }
+Real& Physics::GetMassRef() {
+    Gravity::MarkChanged();
+    return Component_Storage::GetPhysicsData().mass[entity];
+}
 
 /**
  * @brief Sets rotational velocity
  * 
  * @param rotVel New rotational velocity
  */
-void Physics::SetRotationalVelocity(glm::vec3 rotVel) { rotationalVelocity = rotVel; }
+void Physics::SetRotationalVelocity(glm::vec3 rotVel) { Component_Storage::GetPhysicsData().rotationalVelocity[entity] = rotVel; }
 
 /**
  * @brief Returns rotational velocity
  * 
  * @return glm::vec3 
  */
-glm::vec3 Physics::GetRotationalVelocity() const { return rotationalVelocity; }
+glm::vec3 Physics::GetRotationalVelocity() const { return Component_Storage::GetPhysicsData().rotationalVelocity[entity]; }
 
 /**
  * @brief Returns reference to rotational velocity
  * 
  * @return glm::vec3& 
  */
-glm::vec3& Physics::GetRotationalVelocityRef() { return rotationalVelocity; }
+glm::vec3& Physics::GetRotationalVelocityRef() { return Component_Storage::GetPhysicsData().rotationalVelocity[entity]; }
 
 /**
- * @brief Updates the physics of the object
+ * @brief Has the object pulled by every other object this step (see Gravity).
+ *        The pull is found by the Integrator at the positions it needs
  * 
  */
-void Physics::Update() {
-      // Finding the acceleration of the object using F=ma
-    acceleration = forces / mass;
-
-      // Updating velocity
-    velocity += (acceleration * Engine::GetDt());
-
-      // Updating position
-    Transform* transform = GetParent()->GetComponent<Transform>();
-    glm::vec3 position = transform->GetPosition();
-    transform->SetOldPosition(position);
-    position = (velocity * Engine::GetDt()) + position;
-    transform->SetPosition(position);
-
-      // Updating rotation
-    glm::vec3 rotation = transform->GetRotation();
-    rotation = (rotationalVelocity * Engine::GetDt()) + rotation;
-    transform->SetRotation(rotation);
-
-      // Resetting the forces acting on the object
-    forces = glm::vec3(0.f, 0.f, 0.f);
+void Physics::UpdateGravity() {
+    Component_Storage::GetPhysicsData().usesGravity[entity] = 1;
 }
 
 /**
- * @brief Calculates the gravitational pull each object has on each other
+ * @brief Returns the objects within the neighbor cutoff of the object (empty
+ *        when the preset has no neighbor lists)
  * 
+ * @return std::vector<Object*> 
  */
-void Physics::UpdateGravity() {
-      // Gets the needed components for the current object
-    Object* object = GetParent();
-    Transform* transform = object->GetComponent<Transform>();
-    Physics* physics = object->GetComponent<Physics>();
-    glm::vec3 position = transform->GetPosition();
-
-      // For each object
-    for (unsigned i = 0; i < Object_Manager::GetSize(); ++i) {
-        if ((int)i == object->GetId()) continue;
-          // Gets needed components for the object being checked
-        Object* other = Object_Manager::FindObject(i);
-        Physics* otherPhysics = other->GetComponent<Physics>();
-        Transform* otherTransform = other->GetComponent<Transform>();
-        glm::vec3 otherPosition = otherTransform->GetPosition();
-          // Finding the distance between the objects
-        double distance = sqrt(pow(double(otherPosition.x - position.x), 2.0) + 
-            pow(double(otherPosition.y - position.y), 2.0) +
-            pow(double(otherPosition.z - position.z), 2.0));
-          // Calculating the force the objects apply on each other
-        double magnitude = Engine::GetGravConst() * ((physics->mass * otherPhysics->mass)) / pow(distance, 2.0);
-          // Getting the direction (normalized)
-        glm::vec3 direction = otherPosition - position;
-        glm::vec3 normDirection = glm::normalize(direction);
-          // Applying gravitational force to normalized direction
-        glm::vec3 force = normDirection * float(magnitude);
-          // Adding the gravitational force to the forces on object
-        physics->AddForce(force);
+std::vector<Object*> Physics::GetNearbyObjects() const {
+    std::vector<unsigned> found;
+    Neighbor_List::FindNearby(entity, found);
+
+    std::vector<Object*> nearby;
+    for (unsigned other : found) {
+        Component_Storage::ForEach<Physics>(other, other + 1, [&nearby](unsigned, Physics& physics) {
+            nearby.emplace_back(physics.GetParent());
+        });
     }
+    return nearby;
 }
 
 /**
@@ -255,11 +274,27 @@ void Physics::UpdateGravity() {
  * @param reader File to be read from
  */
 void Physics::Read(File_Reader& reader) {
-    initialAcceleration = reader.Read_Vec3("acceleration");
-    initialVelocity = reader.Read_Vec3("velocity");
-    SetAcceleration(initialAcceleration);
-    SetVelocity(initialVelocity);
-    SetMass(reader.Read_Float("mass"));
+    Physics_Data& data = Component_Storage::GetPhysicsData();
+    data.initialAcceleration[entity] = reader.Read_Real_Vec3("acceleration");
+    data.initialVelocity[entity] = reader.Read_Real_Vec3("velocity");
+    SetAcceleration(data.initialAcceleration[entity]);
+    SetVelocity(data.initialVelocity[entity]);
+    SetMass(reader.Read_Real("mass"));
+}
+
+/**
+ * @brief Reads the values a template sets from another Physics (the one kept
+ *        by a Prototype)
+ * 
+ * @param other 
+ */
+void Physics::Read(const Physics& other) {
+    Physics_Data& data = Component_Storage::GetPhysicsData();
+    data.initialAcceleration[entity] = data.initialAcceleration[other.entity];
+    data.initialVelocity[entity] = data.initialVelocity[other.entity];
+    SetAcceleration(data.initialAcceleration[entity]);
+    SetVelocity(data.initialVelocity[entity]);
+    SetMass(other.GetMass());
 }
 
 /**
@@ -268,16 +303,40 @@ void Physics::Read(File_Reader& reader) {
  * @param writer 
  */
 void Physics::Write(File_Writer& writer) {
-    writer.Write_Vec3("acceleration", initialAcceleration);
-    writer.Write_Vec3("velocity", initialVelocity);
-    writer.Write_Value("mass", mass);
+    Physics_Data& data = Component_Storage::GetPhysicsData();
+    writer.Write_Vec3("acceleration", data.initialAcceleration[entity]);
+    writer.Write_Vec3("velocity", data.initialVelocity[entity]);
+    writer.Write_Value("mass", data.mass[entity]);
 }
 
 /**
- * @brief Gets the CType of Physics (used in Object::GetComponent<>())
+ * @brief Moves the data of the component to another entity
  * 
- * @return CType 
+ * @param newEntity 
  */
-CType Physics::GetCType() {
-    return CType::CPhysics;
+void Physics::MoveTo(unsigned newEntity) {
+    if (newEntity == entity) return;
+
+    Physics_Data& data = Component_Storage::GetPhysicsData();
+    data.acceleration[newEntity] = data.acceleration[entity];
+    data.forces[newEntity] = data.forces[entity];
+    data.heldForces[newEntity] = data.heldForces[entity];
+    data.velocity[newEntity] = data.velocity[entity];
+    data.initialVelocity[newEntity] = data.initialVelocity[entity];
+    data.initialAcceleration[newEntity] = data.initialAcceleration[entity];
+    data.rotationalVelocity[newEntity] = data.rotationalVelocity[entity];
+    data.mass[newEntity] = data.mass[entity];
+    data.usesGravity[newEntity] = data.usesGravity[entity];
+    data.restTime[newEntity] = data.restTime[entity];
+    data.isSleeping[newEntity] = data.isSleeping[entity];
+    data.blockLevel[newEntity] = data.blockLevel[entity];
+    data.blockGravity[newEntity] = data.blockGravity[entity];
+    data.endGravity[newEntity] = data.endGravity[entity];
+    data.hasEndGravity[newEntity] = 0;
+    data.isUsed[newEntity] = 1;
+    data.isUsed[entity] = 0;
+
+    if (ownsEntity) Component_Storage::ReleaseEntity(entity);
+    entity = newEntity;
+    ownsEntity = false;
 }
@@ -14,59 +14,68 @@
 #define PHYSICS_HPP
 
 // std includes //
+#include <vector>
 #include <vec3.hpp>
 
 // Engine includes //
 #include "component.hpp"
 #include "file_reader.hpp"
 #include "file_writer.hpp"
+#include "pool.hpp"
+#include "precision.hpp"
 
 /*! Physics class */
-class Physics : public Component {
+class Physics : public Component, public Pooled<Physics> {
     public:
         Physics();
         Physics(const Physics& other);
         Physics(File_Reader& reader);
-        Physics* Clone() const;
+        ~Physics();
+        Physics* Clone() const override;
 
-        void SetAcceleration(glm::vec3 accel);
-        glm::vec3 GetAcceleration() const;
-        glm::vec3& GetAccelerationRef();
+        void SetParent(Object* object);
+        unsigned GetEntity() const;
 
-        void SetForces(glm::vec3 force);
-        void AddForce(glm::vec3 force);
-        glm::vec3 GetForces() const;
-        glm::vec3& GetForcesRef();
+        void SetAcceleration(Vec3 accel);
+        Vec3 GetAcceleration() const;
+        Vec3& GetAccelerationRef();
+
+        void SetForces(Vec3 force);
+        void AddForce(Vec3 force);
+        Vec3 GetForces() const;
+        Vec3& GetForcesRef();
         void ApplyForce(glm::vec3 direction, float power);
 
-        void SetVelocity(glm::vec3 vel);
-        glm::vec3 GetVelocity() const;
-        glm::vec3& GetVelocityRef();
+        void SetVelocity(Vec3 vel);
+        Vec3 GetVelocity() const;
+        Vec3& GetVelocityRef();
 
         void SetRotationalVelocity(glm::vec3 rotVel);
         glm::vec3 GetRotationalVelocity() const;
         glm::vec3& GetRotationalVelocityRef();
 
-        void SetMass(float ma);
-        float GetMass() const;
-        float& GetMassRef();
-
-        void Update();
+        void SetMass(Real ma);
+        Real GetMass() const;
+        Real& GetMassRef();
 
         void UpdateGravity();
+        std::vector<Object*> GetNearbyObjects() const;
 
         void Read(File_Reader& reader);
+        void Read(const Physics& other);
         void Write(File_Writer& writer);
 
-        static CType GetCType();
+        /**
+         * @brief Gets the CType of Physics (used in Object::GetComponent<>())
+         * 
+         * @return CType 
+         */
+        static constexpr CType GetCType() { return TypeOf<Physics>(); }
+    private:
+        void MoveTo(unsigned newEntity);
     private:
-        glm::vec3 acceleration;        //!< Acceleration of object
-        glm::vec3 forces;              //!< Forces acting on object (reset at end of each update)
-        glm::vec3 velocity;            //!< Velocity of object
-        glm::vec3 initialVelocity;     //!< Starting velocity
-        glm::vec3 initialAcceleration; //!< Starting acceleration
-        glm::vec3 rotationalVelocity;  //!< How fast is the object rotating
-        float mass;                    //!< Mass of object
+        unsigned entity; //!< Index of the data in Component_Storage
+        bool ownsEntity; //!< Whether the entity is this component's own (not attached yet)
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,183 @@
+/**
+ * @file pool.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-11
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef POOL_HPP
+#define POOL_HPP
+
+// std includes //
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/*! Pool class (fixed size slots for one type, handed out from large blocks) */
+template <typename T>
+class Pool {
+    public:
+        static const std::size_t slotsPerBlock = 1024; //!< Number of slots in each block
+
+        Pool() : freeSlot(nullptr), usedCount(0) {}
+        ~Pool() { ReleaseBlocks(); }
+
+        /**
+         * @brief Gives out a slot big enough for a T. A new block is made when
+         *        every slot is in use
+         *
+         * @return void*
+         */
+        void* Allocate() {
+            if (!freeSlot) AddBlock();
+
+            Slot* slot = freeSlot;
+            freeSlot = slot->next;
+            ++usedCount;
+            return slot;
+        }
+
+        /**
+         * @brief Gives a slot back to the pool
+         *
+         * @param pointer Slot given by Allocate
+         */
+        void Free(void* pointer) {
+            if (!pointer) return;
+
+            Slot* slot = static_cast<Slot*>(pointer);
+            slot->next = freeSlot;
+            freeSlot = slot;
+            --usedCount;
+        }
+
+        /**
+         * @brief Frees every block at once. Does nothing while slots are still
+         *        in use
+         *
+         * @return true The blocks were freed
+         * @return false Some slots are still in use
+         */
+        bool Release() {
+            if (usedCount > 0) return false;
+
+            ReleaseBlocks();
+            return true;
+        }
+
+        /**
+         * @brief Returns the number of slots in use
+         *
+         * @return std::size_t
+         */
+        std::size_t GetUsedCount() const { return usedCount; }
+    private:
+        /*! Free slot (the memory of a T while it isn't being used) */
+        union Slot {
+            Slot* next;                                  //!< Next free slot
+            alignas(T) unsigned char storage[sizeof(T)]; //!< Memory of the T
+        };
+
+        /**
+         * @brief Makes a new block and adds its slots to the free list
+         *
+         */
+        void AddBlock() {
+            Slot* block = static_cast<Slot*>(::operator new(slotsPerBlock * sizeof(Slot), std::align_val_t(alignof(Slot))));
+            blocks.emplace_back(block);
+
+              // Linking the slots in order so they are handed out front to back
+            for (std::size_t i = 0; i < slotsPerBlock - 1; ++i) {
+                block[i].next = &block[i + 1];
+            }
+            block[slotsPerBlock - 1].next = freeSlot;
+            freeSlot = block;
+        }
+
+        /**
+         * @brief Frees every block
+         *
+         */
+        void ReleaseBlocks() {
+            for (Slot* block : blocks) {
+                ::operator delete(block, std::align_val_t(alignof(Slot)));
+            }
+            blocks.clear();
+            freeSlot = nullptr;
+            usedCount = 0;
+        }
+    private:
+        std::vector<Slot*> blocks; //!< Every block made by the pool
+        Slot* freeSlot;            //!< First free slot
+        std::size_t usedCount;     //!< Number of slots in use
+};
+
+/*! Pooled class (inheriting from it makes new and delete of T use a Pool<T>) */
+template <typename T>
+class Pooled {
+    public:
+        /**
+         * @brief Takes memory for a T from the pool (only called on the main thread)
+         *
+         * @param size
+         * @return void*
+         */
+        static void* operator new(std::size_t size) {
+              // Classes deriving from T are a different size
+            if (size != sizeof(T)) return ::operator new(size);
+            return GetPool().Allocate();
+        }
+
+        /**
+         * @brief Gives memory of a T back to the pool
+         *
+         * @param pointer
+         * @param size
+         */
+        static void operator delete(void* pointer, std::size_t size) {
+            if (size != sizeof(T)) { ::operator delete(pointer); return; }
+            GetPool().Free(pointer);
+        }
+
+        /**
+         * @brief Placement new (libraries like sol construct into their own memory)
+         *
+         * @param place
+         * @return void*
+         */
+        static void* operator new(std::size_t, void* place) { return place; }
+        static void operator delete(void*, void*) {}
+
+        /**
+         * @brief Frees all of the memory of the pool at once. Only works once
+         *        every T has been deleted
+         *
+         * @return true
+         * @return false
+         */
+        static bool ReleasePool() { return GetPool().Release(); }
+
+        /**
+         * @brief Returns the number of T that haven't been deleted
+         *
+         * @return std::size_t
+         */
+        static std::size_t GetPoolUsedCount() { return GetPool().GetUsedCount(); }
+    private:
+        /**
+         * @brief Returns the pool of T
+         *
+         * @return Pool<T>&
+         */
+        static Pool<T>& GetPool() {
+            static Pool<T> pool;
+            return pool;
+        }
+};
+
+#endif
@@ -0,0 +1,31 @@
+/**
+ * @file precision.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-16
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef PRECISION_HPP
+#define PRECISION_HPP
+
+// Library includes //
+#include <vec3.hpp>
+
+  // The simulation state (positions, velocities, forces and masses) and the
+  // math that steps it use Real. Building with -DPENGINE_DOUBLE_PRECISION makes
+  // it double for large orbits, otherwise it is float (twice as many lanes per
+  // SIMD register). What is drawn (matrices, rotation and scale) is always float
+#ifdef PENGINE_DOUBLE_PRECISION
+typedef double Real; //!< Scalar the simulation state is kept in
+#else
+typedef float Real;  //!< Scalar the simulation state is kept in
+#endif
+
+typedef glm::vec<3, Real> Vec3; //!< Vector the simulation state is kept in
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file prototype.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-13
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// Engine includes //
+#include "behavior.hpp"
+#include "file_reader.hpp"
+#include "prototype.hpp"
+
+/**
+ * @brief Reads the template file and makes the components every object made
+ *        from it starts as. The file isn't kept
+ *
+ * @param templateName_ Filename of the template
+ * @return true
+ * @return false
+ */
+bool Prototype::Load(std::string templateName_) {
+    File_Reader reader;
+    if (!reader.Read_File(templateName_)) return false;
+
+    templateName = templateName_;
+    name = reader.Read_String("name");
+    model.reset(new Model(reader));
+    physics.reset(new Physics(reader));
+    transform.reset(new Transform(reader));
+    scripts = Behavior::ReadScripts(reader);
+    return true;
+}
+
+/**
+ * @brief Returns the filename of the template
+ *
+ * @return const std::string&
+ */
+const std::string& Prototype::GetTemplateName() const { return templateName; }
+
+/**
+ * @brief Returns the name written in the template
+ *
+ * @return const std::string&
+ */
+const std::string& Prototype::GetName() const { return name; }
+
+/**
+ * @brief Returns the Model of the template (objects clone it)
+ *
+ * @return const Model&
+ */
+const Model& Prototype::GetModel() const { return *model; }
+
+/**
+ * @brief Returns the Physics of the template (objects clone it)
+ *
+ * @return const Physics&
+ */
+const Physics& Prototype::GetPhysics() const { return *physics; }
+
+/**
+ * @brief Returns the Transform of the template (objects clone it)
+ *
+ * @return const Transform&
+ */
+const Transform& Prototype::GetTransform() const { return *transform; }
+
+/**
+ * @brief Returns the lua scripts of the template. Behaviors share the list and
+ *        copy it before changing it
+ *
+ * @return std::shared_ptr<std::vector<std::string>>
+ */
+std::shared_ptr<std::vector<std::string>> Prototype::GetScripts() const { return scripts; }
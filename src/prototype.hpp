@@ -0,0 +1,46 @@
+/**
+ * @file prototype.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-13
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef PROTOTYPE_HPP
+#define PROTOTYPE_HPP
+
+// std includes //
+#include <memory>
+#include <string>
+#include <vector>
+
+// Engine includes //
+#include "model.hpp"
+#include "physics.hpp"
+#include "transform.hpp"
+
+/*! Prototype class (an object template read once and shared by every object made from it) */
+class Prototype {
+    public:
+        bool Load(std::string templateName_);
+
+        const std::string& GetTemplateName() const;
+        const std::string& GetName() const;
+        const Model& GetModel() const;
+        const Physics& GetPhysics() const;
+        const Transform& GetTransform() const;
+        std::shared_ptr<std::vector<std::string>> GetScripts() const;
+    private:
+        std::string templateName;                          //!< Filename of the template
+        std::string name;                                  //!< Name written in the template
+        std::unique_ptr<const Model> model;                //!< Model read from the template (cloned by objects)
+        std::unique_ptr<const Physics> physics;            //!< Physics read from the template (cloned by objects)
+        std::unique_ptr<const Transform> transform;        //!< Transform read from the template (cloned by objects)
+        std::shared_ptr<std::vector<std::string>> scripts; //!< Lua scripts of the template
+};
+
+#endif
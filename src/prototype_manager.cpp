@@ -0,0 +1,77 @@
+/**
+ * @file prototype_manager.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-13
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+// Engine includes //
+#include "prototype_manager.hpp"
+#include "trace.hpp"
+
+static Prototype_Manager* prototype_manager = nullptr; //!< Prototype_Manager object
+
+/**
+ * @brief Initializes the prototype_manager
+ *
+ * @return true
+ * @return false
+ */
+bool Prototype_Manager::Initialize() {
+      // Initializing prototype_manager
+    prototype_manager = new Prototype_Manager;
+    if (!prototype_manager) {
+        Trace::Message("Prototype Manager was not initialized.\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks if the template has already been read in. If yes then it
+ *        returns that prototype. If no it reads it in and keeps it
+ *
+ * @param templateName Filename of the template
+ * @return std::shared_ptr<const Prototype> Prototype (nullptr if the file couldn't be read)
+ */
+std::shared_ptr<const Prototype> Prototype_Manager::Get(std::string templateName) {
+    auto found = prototype_manager->prototypes.find(templateName);
+    if (found != prototype_manager->prototypes.end()) return found->second;
+
+      // Reading the template, then adding it to the list
+    std::shared_ptr<Prototype> prototype = std::make_shared<Prototype>();
+    if (!prototype->Load(templateName)) return nullptr;
+    prototype_manager->prototypes.emplace(templateName, prototype);
+
+    return prototype;
+}
+
+/**
+ * @brief Drops the kept prototype of a template (used when the file is
+ *        written). Objects using it keep their copy, the next Get reads the
+ *        file again
+ *
+ * @param templateName Filename of the template
+ * @return void
+ */
+void Prototype_Manager::Forget(std::string templateName) {
+    prototype_manager->prototypes.erase(templateName);
+}
+
+/**
+ * @brief Deletes prototype_manager. Prototypes still used by objects are
+ *        deleted with the last object using them
+ *
+ * @return void
+ */
+void Prototype_Manager::Shutdown() {
+    if (!prototype_manager) return;
+
+    delete prototype_manager;
+    prototype_manager = nullptr;
+}
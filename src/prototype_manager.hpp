@@ -0,0 +1,35 @@
+/**
+ * @file prototype_manager.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 2021-08-13
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#pragma once
+#ifndef PROTOTYPE_MANAGER_HPP
+#define PROTOTYPE_MANAGER_HPP
+
+// std includes //
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Engine includes //
+#include "prototype.hpp"
+
+/*! Prototype_Manager class */
+class Prototype_Manager {
+    public:
+        static bool Initialize();
+        static std::shared_ptr<const Prototype> Get(std::string templateName);
+        static void Forget(std::string templateName);
+        static void Shutdown();
+    private:
+        std::unordered_map<std::string, std::shared_ptr<const Prototype>> prototypes; //!< Prototypes that have been read
+};
+
+#endif
@@ -13,7 +13,7 @@
 #include "random.hpp"
 #include "trace.hpp"
 
-static Random* random = nullptr; //!< Random object
+static Random* random_system = nullptr; //!< Random object
 
 /**
  * @brief Initializes the random system
@@ -23,8 +23,8 @@ static Random* random = nullptr; //!< Random object
  */
 bool Random::Initialize() {
       // Initializing random
-    random = new Random;
-    if (!random) {
+    random_system = new Random;
+    if (!random_system) {
         Trace::Message("Random failed to initialize.");
         return false;
     }
@@ -38,10 +38,10 @@ bool Random::Initialize() {
  * @return void
  */
 void Random::Shutdown() {
-    if (!random) return;
+    if (!random_system) return;
 
-    delete random;
-    random = nullptr;
+    delete random_system;
+    random_system = nullptr;
 }
 
 /**
@@ -53,7 +53,7 @@ void Random::Shutdown() {
  */
 glm::vec3 Random::random_vec3(float low, float high) {
       // Setup random gen
-    std::mt19937 gen(random->rd());
+    std::mt19937 gen(random_system->rd());
     std::uniform_real_distribution<> dist(low, high);
       // Gen random vec3
     glm::vec3 result_vec3 = { dist(gen), dist(gen), dist(gen) };
@@ -69,7 +69,7 @@ glm::vec3 Random::random_vec3(float low, float high) {
  */
 float Random::random_float(float low, float high) {
       // Setup random gen
-    std::mt19937 gen(random->rd());
+    std::mt19937 gen(random_system->rd());
     std::uniform_real_distribution<> dist(low, high);
       // Gen random float
     return dist(gen);
@@ -16,6 +16,7 @@
 #include <glew.h>
 
 // Engine includes //
+#include "engine.hpp"
 #include "shader.hpp"
 #include "trace.hpp"
 
@@ -36,8 +37,8 @@ bool Shader::Initialize(File_Reader& settings) {
     }
 
     //LoadShader("src/shaders/vertex.glsl", "src/shaders/fragment.glsl");
-    LoadShader(std::string(getenv("USERPROFILE")) + "/Documents/pEngine/shaders/" + settings.Read_String("vertexShader") + ".glsl", 
-        std::string(getenv("USERPROFILE")) + "/Documents/pEngine/shaders/" + settings.Read_String("fragShader") + ".glsl");
+    LoadShader(Engine::GetDataPath() + "shaders/" + settings.Read_String("vertexShader") + ".glsl", 
+        Engine::GetDataPath() + "shaders/" + settings.Read_String("fragShader") + ".glsl");
     return true;
 }
 
@@ -55,8 +56,8 @@ bool Shader::Initialize() {
     }
 
     //LoadShader("src/shaders/vertex.glsl", "src/shaders/fragment.glsl");
-    LoadShader(std::string(getenv("USERPROFILE")) + "/Documents/pEngine/shaders/vertex.glsl", 
-        std::string(getenv("USERPROFILE")) + "/Documents/pEngine/shaders/fragment.glsl");
+    LoadShader(Engine::GetDataPath() + "shaders/vertex.glsl", 
+        Engine::GetDataPath() + "shaders/fragment.glsl");
     return true;
 }
 
@@ -13,6 +13,7 @@
 #include <glew.h>
 
 // Engine includes //
+#include "engine.hpp"
 #include "shader.hpp"
 #include "texture.hpp"
 #include "trace.hpp"
@@ -34,7 +35,7 @@ Texture::~Texture() {
  */
 bool Texture::Load(std::string textureName_) {
     FILE *fp;
-    std::string filename = std::string(getenv("USERPROFILE")) + "/Documents/pEngine/textures/" + textureName_;
+    std::string filename = Engine::GetDataPath() + "textures/" + textureName_;
     textureName = filename ;
 
       // Opening the file
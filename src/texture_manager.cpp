@@ -43,6 +43,9 @@ bool Texture_Manager::Initialize() {
  * @return Texture* 
  */
 Texture* Texture_Manager::Get(File_Reader& reader) {
+      // Nothing is loaded when running without graphics
+    if (!texture_manager) return nullptr;
+
       // Getting texture's filename
     std::string filename = reader.Read_String("textureToLoad");
       // Looking for texture in list of loaded textures
@@ -69,6 +72,9 @@ Texture* Texture_Manager::Get(File_Reader& reader) {
  * @return Texture* 
  */
 Texture* Texture_Manager::Get(std::string textureName) {
+      // Nothing is loaded when running without graphics
+    if (!texture_manager) return nullptr;
+
       // Looking for texture in list of loaded textures
     for (Texture* texture : texture_manager->textures) {
         if (texture->GetTextureName().compare(textureName) == 0) {
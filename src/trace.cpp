@@ -14,6 +14,7 @@
 #include <cstdarg>
 
 // Engine includes //
+#include "engine.hpp"
 #include "trace.hpp"
 
 static Trace* trace = nullptr; //!< Trace object
@@ -27,7 +28,7 @@ void Trace::Initialize() {
     trace = new Trace;
 
       // Opens output file
-    trace->trace_stream.open(std::string(getenv("USERPROFILE")) + "/Documents/pEngine/trace.log", std::ofstream::out);
+    trace->trace_stream.open(Engine::GetDataPath() + "trace.log", std::ofstream::out);
     if (!trace->trace_stream) std::cout << "Trace file wasn't opened successfully.\n";
 }
 
@@ -38,9 +39,7 @@ void Trace::Initialize() {
  * @return void
  */
 void Trace::Message(std::string message) {
-    if (!trace->trace_stream) return;
-    
-    trace->trace_stream << message;
+    if (trace->trace_stream) trace->trace_stream << message;
     std::cout << message;
 }
 
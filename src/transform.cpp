@@ -9,23 +9,59 @@
  * 
  */
 
+// Library includes //
+#include <glm.hpp>
+#include <gtc/matrix_transform.hpp>
+
 // Engine includes //
+#include "component_storage.hpp"
+#include "gravity.hpp"
+#include "object.hpp"
 #include "transform.hpp"
 
 /**
- * @brief Creates Transform object with default values
+ * @brief Makes a world matrix (translate, rotate x y z in degrees, then scale)
  * 
  */
-Transform::Transform() : Component(CType::CTransform), 
-    position(glm::vec3(0.f, 0.f, 0.f)), scale(glm::vec3(1.f, 1.f, 1.f)), rotation(glm::vec3(0.f, 0.f, 0.f)) {}
+static inline glm::mat4 MakeMatrix(glm::vec3 position, glm::vec3 rotation, glm::vec3 scale) {
+    glm::mat4 matrix = glm::translate(glm::mat4(1.f), position);
+    matrix = glm::rotate(matrix, (rotation.x / 180.f) * glm::pi<float>(), glm::vec3(1, 0, 0));
+    matrix = glm::rotate(matrix, (rotation.y / 180.f) * glm::pi<float>(), glm::vec3(0, 1, 0));
+    matrix = glm::rotate(matrix, (rotation.z / 180.f) * glm::pi<float>(), glm::vec3(0, 0, 1));
+    return glm::scale(matrix, scale);
+}
+
+/**
+ * @brief Creates Transform object with default values. Data is kept in its own
+ *        entity until the component is attached to an object
+ * 
+ */
+Transform::Transform() : Component(GetCType()), 
+    entity(Component_Storage::CreateEntity()), ownsEntity(true) {
+    Transform_Data& data = Component_Storage::GetTransformData();
+    data.position[entity] = Vec3(0);
+    data.oldPosition[entity] = Vec3(0);
+    data.scale[entity] = glm::vec3(1.f, 1.f, 1.f);
+    data.rotation[entity] = glm::vec3(0.f, 0.f, 0.f);
+    data.oldRotation[entity] = glm::vec3(0.f, 0.f, 0.f);
+    data.startPosition[entity] = Vec3(0);
+    data.isDirty[entity] = 1;
+    data.isStepped[entity] = 0;
+    data.isUsed[entity] = 1;
+}
 
 /**
  * @brief Copy constructor
  * 
  * @param other 
  */
-Transform::Transform(const Transform& other) : Component(CType::CTransform) { 
-    *this = other;
+Transform::Transform(const Transform& other) : Transform() { 
+    SetPosition(other.GetPosition());
+    SetOldPosition(other.GetOldPosition());
+    SetScale(other.GetScale());
+    SetRotation(other.GetRotation());
+    SetOldRotation(other.GetOldRotation());
+    SetStartPosition(other.GetStartPosition());
 }
 
 /**
@@ -33,11 +69,19 @@ Transform::Transform(const Transform& other) : Component(CType::CTransform) {
  * 
  * @param reader File to use for making Transform object
  */
-Transform::Transform(File_Reader& reader) : Component(CType::CTransform), 
-    position(glm::vec3(0.f, 0.f, 0.f)), scale(glm::vec3(1.f, 1.f, 1.f)), rotation(glm::vec3(0.f, 0.f, 0.f)) {
+Transform::Transform(File_Reader& reader) : Transform() {
     Read(reader);
 }
 
+/**
+ * @brief Marks the data as unused (and gives back the entity if it's its own)
+ * 
+ */
+Transform::~Transform() {
+    Component_Storage::GetTransformData().isUsed[entity] = 0;
+    if (ownsEntity) Component_Storage::ReleaseEntity(entity);
+}
+
 /**
  * @brief Clones current Transform object
  * 
@@ -47,111 +91,260 @@ Transform* Transform::Clone() const {
     return new Transform(*this);
 }
 
+/**
+ * @brief Attaches the component to an object and moves its data to the
+ *        object's entity
+ * 
+ * @param object 
+ */
+void Transform::SetParent(Object* object) {
+    Component::SetParent(object);
+    if (object) MoveTo(object->GetEntity());
+}
+
+/**
+ * @brief Returns the entity the data of this component is stored at
+ * 
+ * @return unsigned 
+ */
+unsigned Transform::GetEntity() const { return entity; }
+
 /**
  * @brief Sets position of object
  * 
  * @param pos 
  */
-void Transform::SetPosition(glm::vec3 pos) { position = pos; }
+void Transform::SetPosition(Vec3 pos) {
+    Transform_Data& data = Component_Storage::GetTransformData();
+    if (data.position[entity] == pos) return;
+
+      // Placing the object directly isn't blended with where it was
+    data.position[entity] = pos;
+    data.oldPosition[entity] = pos;
+    MarkDirty();
+    Gravity::MarkChanged();
+}
 
 /**
  * @brief Returns position of object
  * 
- * @return glm::vec3 
+ * @return Vec3 
  */
-glm::vec3 Transform::GetPosition() const { return position; }
+Vec3 Transform::GetPosition() const { return Component_Storage::GetTransformData().position[entity]; }
 
 /**
- * @brief Returns position reference of object
+ * @brief Returns position reference of object. The matrix is remade since the
+ *        position may be changed through it, and it isn't blended with where
+ *        the last step left it
  * 
- * @return glm::vec3& 
+ * @return Vec3& 
  */
-glm::vec3& Transform::GetPositionRef() { return position; }
+Vec3& Transform::GetPositionRef() {
+    MarkDirty();
+    Gravity::MarkChanged();
+    Component_Storage::GetTransformData().isStepped[entity] = 0;
+    return Component_Storage::GetTransformData().position[entity];
+}
 
 /**
  * @brief Sets old position of object
  * 
  * @param oldPos 
  */
-void Transform::SetOldPosition(glm::vec3 oldPos) { oldPosition = oldPos; }
+void Transform::SetOldPosition(Vec3 oldPos) { Component_Storage::GetTransformData().oldPosition[entity] = oldPos; }
 
 /**
  * @brief Returns old position of object
  * 
- * @return glm::vec3 
+ * @return Vec3 
  */
-glm::vec3 Transform::GetOldPosition() const { return oldPosition; }
+Vec3 Transform::GetOldPosition() const { return Component_Storage::GetTransformData().oldPosition[entity]; }
 
 /**
  * @brief Sets scale of object
  * 
  * @param sca 
  */
-void Transform::SetScale(glm::vec3 sca) { scale = sca; }
+void Transform::SetScale(glm::vec3 sca) {
+    glm::vec3& scale = Component_Storage::GetTransformData().scale[entity];
+    if (scale == sca) return;
+
+    scale = sca;
+    MarkDirty();
+}
 
 /**
  * @brief Returns scale of object
  * 
  * @return glm::vec3 
  */
-glm::vec3 Transform::GetScale() const { return scale; }
+glm::vec3 Transform::GetScale() const { return Component_Storage::GetTransformData().scale[entity]; }
 
 /**
- * @brief Returns scale reference of object
+ * @brief Returns scale reference of object. The matrix is remade since the
+ *        scale may be changed through it
  * 
  * @return glm::vec3& 
  */
-glm::vec3& Transform::GetScaleRef() { return scale; }
+glm::vec3& Transform::GetScaleRef() {
+    MarkDirty();
+    return Component_Storage::GetTransformData().scale[entity];
+}
 
 /**
  * @brief Sets rotation of object
  * 
  * @param rot 
  */
-void Transform::SetRotation(glm::vec3 rot) { rotation = rot; }
+void Transform::SetRotation(glm::vec3 rot) {
+    Transform_Data& data = Component_Storage::GetTransformData();
+    if (data.rotation[entity] == rot) return;
+
+      // Turning the object directly isn't blended with how it was turned
+    data.rotation[entity] = rot;
+    data.oldRotation[entity] = rot;
+    MarkDirty();
+}
 
 /**
  * @brief Returns rotation of object
  * 
  * @return float 
  */
-glm::vec3 Transform::GetRotation() const { return rotation; }
+glm::vec3 Transform::GetRotation() const { return Component_Storage::GetTransformData().rotation[entity]; }
 
 /**
- * @brief Returns rotation reference of object
+ * @brief Returns rotation reference of object. The matrix is remade since the
+ *        rotation may be changed through it
  * 
  * @return glm::vec3& 
  */
-glm::vec3& Transform::GetRotationRef() { return rotation; }
+glm::vec3& Transform::GetRotationRef() {
+    MarkDirty();
+    Component_Storage::GetTransformData().isStepped[entity] = 0;
+    return Component_Storage::GetTransformData().rotation[entity];
+}
+
+/**
+ * @brief Sets old rotation of object
+ * 
+ * @param oldRot 
+ */
+void Transform::SetOldRotation(glm::vec3 oldRot) { Component_Storage::GetTransformData().oldRotation[entity] = oldRot; }
+
+/**
+ * @brief Returns old rotation of object
+ * 
+ * @return glm::vec3 
+ */
+glm::vec3 Transform::GetOldRotation() const { return Component_Storage::GetTransformData().oldRotation[entity]; }
 
 /**
  * @brief Sets the start position of the object
  * 
  * @param startPosition_ 
  */
-void Transform::SetStartPosition(glm::vec3 startPosition_) { startPosition = startPosition_; }
+void Transform::SetStartPosition(Vec3 startPosition_) { Component_Storage::GetTransformData().startPosition[entity] = startPosition_; }
 
 /**
  * @brief Returns the saved start position of the object
  * 
- * @return glm::vec3 
+ * @return Vec3 
  */
-glm::vec3 Transform::GetStartPosition() const { return startPosition; }
+Vec3 Transform::GetStartPosition() const { return Component_Storage::GetTransformData().startPosition[entity]; }
 
 /**
  * @brief Returns a reference to the start position of the object
  * 
- * @return glm::vec3& 
+ * @return Vec3& 
  */
-glm::vec3& Transform::GetStartPositionRef() { return startPosition; }
+Vec3& Transform::GetStartPositionRef() { return Component_Storage::GetTransformData().startPosition[entity]; }
+
+/**
+ * @brief Returns the world matrix of the object (translate, rotate x y z in
+ *        degrees, then scale). Only remade when position, rotation or scale
+ *        has changed
+ * 
+ * @return const glm::mat4& 
+ */
+const glm::mat4& Transform::GetMatrix() {
+    UpdateMatrices(entity, entity + 1);
+    return Component_Storage::GetTransformData().matrix[entity];
+}
+
+/**
+ * @brief Remakes the world matrix of every changed Transform in [begin, end)
+ * 
+ * @param begin First entity
+ * @param end One past the last entity
+ */
+void Transform::UpdateMatrices(unsigned begin, unsigned end) {
+    Transform_Data& data = Component_Storage::GetTransformData();
+
+    for (unsigned i = begin; i < end; ++i) {
+        if (!data.isDirty[i] || !data.isUsed[i]) continue;
+
+        data.matrix[i] = MakeMatrix(glm::vec3(data.position[i]), data.rotation[i], data.scale[i]);
+        data.isDirty[i] = 0;
+    }
+}
+
+/**
+ * @brief Returns the matrix the object is drawn with (set by UpdateRenderMatrices)
+ * 
+ * @return const glm::mat4& 
+ */
+const glm::mat4& Transform::GetRenderMatrix() const { return Component_Storage::GetTransformData().renderMatrix[entity]; }
+
+/**
+ * @brief Finds the matrix every Transform in [begin, end) is drawn with. Objects
+ *        the Integrator moved in the last step are blended between the last
+ *        two steps, the rest (asleep, placed or pushed directly) use their
+ *        world matrix
+ * 
+ * @param begin First entity
+ * @param end One past the last entity
+ * @param alpha How far the frame is between the last step and the next (0 to 1)
+ */
+void Transform::UpdateRenderMatrices(unsigned begin, unsigned end, float alpha) {
+    UpdateMatrices(begin, end);
+
+    Transform_Data& data = Component_Storage::GetTransformData();
+
+    for (unsigned i = begin; i < end; ++i) {
+        if (!data.isUsed[i]) continue;
+
+        if (!data.isStepped[i] || (data.oldPosition[i] == data.position[i] && data.oldRotation[i] == data.rotation[i])) {
+            data.renderMatrix[i] = data.matrix[i];
+            continue;
+        }
+
+        data.renderMatrix[i] = MakeMatrix(glm::vec3(glm::mix(data.oldPosition[i], data.position[i], Real(alpha))),
+            glm::mix(data.oldRotation[i], data.rotation[i], alpha), data.scale[i]);
+    }
+}
 
 /**
  * @brief Reads data for Transform object from file
  * 
  * @param reader File to read from
  */
-void Transform::Read(File_Reader&) {
+void Transform::Read(File_Reader& reader) {
     //SetRotation(reader.Read_Float("rotation"));
+      // Read in the precision of the simulation state (zero if it isn't there)
+    SetPosition(reader.Read_Real_Vec3("position"));
+    SetStartPosition(GetPosition());
+}
+
+/**
+ * @brief Reads the values a template sets from another Transform (the one
+ *        kept by a Prototype)
+ * 
+ * @param other 
+ */
+void Transform::Read(const Transform& other) {
+    SetPosition(other.GetStartPosition());
+    SetStartPosition(GetPosition());
 }
 
 /**
@@ -160,14 +353,38 @@ void Transform::Read(File_Reader&) {
  * @param writer 
  */
 void Transform::Write(File_Writer& writer) {
-    writer.Write_Vec3("rotation", rotation);
+    writer.Write_Vec3("position", GetStartPosition());
+    writer.Write_Vec3("rotation", GetRotation());
 }
 
 /**
- * @brief Gets the CType of Transform (used in Object::GetComponent<>())
+ * @brief Marks the world matrix as needing to be remade
+ * 
+ */
+void Transform::MarkDirty() { Component_Storage::GetTransformData().isDirty[entity] = 1; }
+
+/**
+ * @brief Moves the data of the component to another entity
  * 
- * @return CType 
+ * @param newEntity 
  */
-CType Transform::GetCType() {
-    return CType::CTransform;
-}
\ No newline at end of file
+void Transform::MoveTo(unsigned newEntity) {
+    if (newEntity == entity) return;
+
+    Transform_Data& data = Component_Storage::GetTransformData();
+    data.position[newEntity] = data.position[entity];
+    data.oldPosition[newEntity] = data.oldPosition[entity];
+    data.scale[newEntity] = data.scale[entity];
+    data.rotation[newEntity] = data.rotation[entity];
+    data.startPosition[newEntity] = data.startPosition[entity];
+    data.oldRotation[newEntity] = data.oldRotation[entity];
+    data.matrix[newEntity] = data.matrix[entity];
+    data.isDirty[newEntity] = data.isDirty[entity];
+    data.isStepped[newEntity] = data.isStepped[entity];
+    data.isUsed[newEntity] = 1;
+    data.isUsed[entity] = 0;
+
+    if (ownsEntity) Component_Storage::ReleaseEntity(entity);
+    entity = newEntity;
+    ownsEntity = false;
+}
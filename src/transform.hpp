@@ -14,27 +14,34 @@
 #define TRANSFORM_HPP
 
 // std includes //
+#include <mat4x4.hpp>
 #include <vec3.hpp>
 
 // Engine includes //
 #include "component.hpp"
 #include "file_reader.hpp"
 #include "file_writer.hpp"
+#include "pool.hpp"
+#include "precision.hpp"
 
 /*! Transform class */
-class Transform : public Component {
+class Transform : public Component, public Pooled<Transform> {
     public:
         Transform();
         Transform(const Transform& other);
         Transform(File_Reader& reader);
-        Transform* Clone() const;
+        ~Transform();
+        Transform* Clone() const override;
 
-        void SetPosition(glm::vec3 pos);
-        glm::vec3 GetPosition() const;
-        glm::vec3& GetPositionRef();
+        void SetParent(Object* object);
+        unsigned GetEntity() const;
 
-        void SetOldPosition(glm::vec3 oldPos);
-        glm::vec3 GetOldPosition() const;
+        void SetPosition(Vec3 pos);
+        Vec3 GetPosition() const;
+        Vec3& GetPositionRef();
+
+        void SetOldPosition(Vec3 oldPos);
+        Vec3 GetOldPosition() const;
 
         void SetScale(glm::vec3 sca);
         glm::vec3 GetScale() const;
@@ -44,20 +51,34 @@ class Transform : public Component {
         glm::vec3 GetRotation() const;
         glm::vec3& GetRotationRef();
 
-        void SetStartPosition(glm::vec3 startPosition_);
-        glm::vec3 GetStartPosition() const;
-        glm::vec3& GetStartPositionRef();
+        void SetOldRotation(glm::vec3 oldRot);
+        glm::vec3 GetOldRotation() const;
+
+        void SetStartPosition(Vec3 startPosition_);
+        Vec3 GetStartPosition() const;
+        Vec3& GetStartPositionRef();
+
+        const glm::mat4& GetMatrix();
+        const glm::mat4& GetRenderMatrix() const;
+        static void UpdateMatrices(unsigned begin, unsigned end);
+        static void UpdateRenderMatrices(unsigned begin, unsigned end, float alpha);
 
         void Read(File_Reader& reader);
+        void Read(const Transform& other);
         void Write(File_Writer& writer);
 
-        static CType GetCType();
+        /**
+         * @brief Gets the CType of Transform (used in Object::GetComponent<>())
+         * 
+         * @return CType 
+         */
+        static constexpr CType GetCType() { return TypeOf<Transform>(); }
+    private:
+        void MoveTo(unsigned newEntity);
+        void MarkDirty();
     private:
-        glm::vec3 position;      //!< Position of object
-        glm::vec3 oldPosition;   //!< Previous position of object
-        glm::vec3 scale;         //!< Scale of object
-        glm::vec3 rotation;      //!< Rotation of object
-        glm::vec3 startPosition; //!< Starting position of the object
+        unsigned entity; //!< Index of the data in Component_Storage
+        bool ownsEntity; //!< Whether the entity is this component's own (not attached yet)
 };
 
 #endif
\ No newline at end of file